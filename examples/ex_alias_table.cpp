@@ -0,0 +1,66 @@
+#include <igraph.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::AliasTable and ig::NeighborAliasIndex,
+// which sample items in proportion to their weights in constant time.
+
+int main() {
+    RNGScope rng(42);
+
+    // Sample indices with probabilities 0.1, 0.2, 0.3, 0 and 0.4.
+    RealVec weights = {1, 2, 3, 0, 4};
+    AliasTable table(weights);
+
+    const igraph_integer_t samples = 100000;
+    RealVec freq(table.size());
+    for (igraph_integer_t i = 0; i < samples; ++i)
+        freq[table.sample()] += 1.0 / samples;
+
+    assert(freq[3] == 0);
+    for (igraph_integer_t i = 0; i < table.size(); ++i) {
+        std::cout << i << ": " << freq[i] << std::endl;
+        assert(std::abs(freq[i] - weights[i] / 10) < 0.01);
+    }
+
+    // A weighted star, in which the centre 0 is connected to vertex v with weight v.
+    Graph star(IntVec{0, 1, 0, 2, 0, 3, 0, 4}, 5);
+    RealVec edge_weights = {1, 2, 3, 4};
+    NeighborAliasIndex index(star, &edge_weights, IGRAPH_ALL);
+    assert(index.degree(0) == 4 && index.degree(1) == 1);
+    assert(index.is_neighbor(0, 2) && ! index.is_neighbor(1, 2));
+
+    // Parallel code should use separate generators, such as RNGStream.
+    RNGStream stream(RNGStream::seed_from_igraph());
+    RealVec nfreq(star.vcount());
+    for (igraph_integer_t i = 0; i < samples; ++i)
+        nfreq[index.sample_neighbor(0, stream)] += 1.0 / samples;
+    for (igraph_integer_t v = 1; v < star.vcount(); ++v)
+        assert(std::abs(nfreq[v] - edge_weights[v - 1] / 10) < 0.01);
+
+    // Edges are sampled with the same probabilities as the neighbours across them.
+    for (igraph_integer_t i = 0; i < 100; ++i)
+        assert(index.sample_edge(2) == 1);
+
+    // Weights must be non-negative and finite.
+    try {
+        AliasTable bad(RealVec{1, -1});
+        assert(false);
+    } catch (const Exception &e) {
+        assert(e.error == IGRAPH_EINVAL);
+    }
+
+    // An empty table cannot be sampled.
+    try {
+        AliasTable().sample();
+        assert(false);
+    } catch (const Exception &e) {
+        assert(e.error == IGRAPH_EINVAL);
+    }
+
+    return 0;
+}
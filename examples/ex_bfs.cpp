@@ -0,0 +1,60 @@
+
+#include <igraph.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::bfs(), a multi-threaded breadth-first search
+// that switches to bottom-up steps when the frontier becomes large.
+
+int main() {
+    RNGScope rng(42);
+
+    igraph_t ig;
+    igraph_erdos_renyi_game_gnm(&ig, 2000, 20000, IGRAPH_DIRECTED, IGRAPH_NO_LOOPS);
+    Graph g(Capture(ig));
+
+    BFSResult res = bfs(g, 0, IGRAPH_OUT);
+
+    // Check the distances against igraph_distances().
+    RealMat expected;
+    igraph_distances(g, expected, igraph_vss_1(0), igraph_vss_all(), IGRAPH_OUT);
+    igraph_integer_t reached = 0, depth = 0;
+    for (igraph_integer_t v = 0; v < g.vcount(); ++v) {
+        if (res.dist[v] < 0) {
+            assert(expected(0, v) == IGRAPH_INFINITY);
+            assert(res.parents[v] == -2);
+            continue;
+        }
+        assert(res.dist[v] == expected(0, v));
+        ++reached;
+        depth = std::max(depth, res.dist[v]);
+
+        // Each parent is one step closer to the source, and connected to the vertex.
+        igraph_integer_t p = res.parents[v];
+        if (v == 0) {
+            assert(p == -1);
+        } else {
+            igraph_integer_t eid;
+            assert(res.dist[p] == res.dist[v] - 1);
+            igraph_get_eid(g, &eid, p, v, IGRAPH_DIRECTED, false);
+            assert(eid >= 0);
+        }
+    }
+
+    std::cout << "Reached " << reached << " vertices in " << depth << " steps." << std::endl;
+
+    // With several sources, each vertex is reached from the nearest one.
+    IntVec sources = {0, 1, 2};
+    BFSResult multi = bfs(g, sources, IGRAPH_IN);
+    igraph_distances(g, expected, igraph_vss_vector(sources), igraph_vss_all(), IGRAPH_IN);
+    for (igraph_integer_t v = 0; v < g.vcount(); ++v) {
+        igraph_real_t nearest = std::min({expected(0, v), expected(1, v), expected(2, v)});
+        assert(multi.dist[v] == (nearest == IGRAPH_INFINITY ? -1 : nearest));
+    }
+
+    return 0;
+}
@@ -0,0 +1,48 @@
+
+#include <igraph.hpp>
+#include "ex_vector_print.hpp"
+
+#include <cassert>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::connected_components(), a multi-threaded alternative
+// to igraph_connected_components(), and ig::LazyComponents, a lazy alternative
+// to igraph_decompose().
+
+int main() {
+    RNGScope rng(42);
+
+    igraph_t ig;
+    igraph_erdos_renyi_game_gnm(&ig, 2000, 1100, IGRAPH_DIRECTED, IGRAPH_NO_LOOPS);
+    Graph g(Capture(ig));
+
+    // Weakly connected components, computed in parallel.
+    Components comps = connected_components(g);
+    std::cout << "Number of components: " << comps.count() << std::endl;
+
+    // The result is the same as that of igraph_connected_components().
+    IntVec membership, sizes;
+    igraph_integer_t count;
+    igraph_connected_components(g, membership, sizes, &count, IGRAPH_WEAK);
+    assert(comps.count() == count);
+    assert(comps.membership == membership);
+    assert(comps.sizes == sizes);
+
+    // LazyComponents only creates the subgraph of a component when it is accessed.
+    LazyComponents lazy(g);
+    igraph_integer_t largest = std::max_element(lazy.components().sizes.begin(),
+                                                lazy.components().sizes.end()) -
+                               lazy.components().sizes.begin();
+
+    Graph giant = lazy[largest];
+    std::cout << "Largest component: " << giant.vcount() << " vertices, "
+              << giant.ecount() << " edges" << std::endl;
+
+    Graph small = lazy[comps.count() - 1];
+    std::cout << "Vertices of the last component: " << lazy.vertices(comps.count() - 1) << std::endl;
+    assert(small.vcount() == comps.sizes[comps.count() - 1]);
+
+    return 0;
+}
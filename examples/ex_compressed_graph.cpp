@@ -0,0 +1,105 @@
+#include <igraph.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+using namespace ig;
+
+// This example illustrates ig::CompressedGraph, which stores neighbour lists
+// with a compact variable-length encoding, and decodes them on the fly.
+
+// The edges of a graph as sorted (from, to) pairs, with from <= to if undirected.
+std::vector<std::pair<igraph_integer_t, igraph_integer_t>> edge_list(const Graph &g) {
+    std::vector<std::pair<igraph_integer_t, igraph_integer_t>> res;
+    for (igraph_integer_t e = 0; e < g.ecount(); ++e) {
+        igraph_integer_t from, to;
+        igraph_edge(g, e, &from, &to);
+        if (! g.is_directed() && from > to)
+            std::swap(from, to);
+        res.emplace_back(from, to);
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+int main() {
+    RNGScope rng(42);
+
+    // Neighbours with nearby IDs compress best: connect each vertex to a few random
+    // vertices within a small distance, and add some loops and multi-edges.
+    const igraph_integer_t n = 10000;
+    IntVec edges;
+    for (igraph_integer_t v = 0; v < n; ++v) {
+        for (igraph_integer_t k = 0; k < 8; ++k) {
+            edges.push_back(v);
+            edges.push_back((v + RNG_INTEGER(0, 100)) % n);
+        }
+    }
+    edges.push_back(0);
+    edges.push_back(0);
+    edges.push_back(5);
+    edges.push_back(9999);
+
+    for (bool directed : {false, true}) {
+        Graph g(edges, n, directed);
+        CompressedGraph cg(g);
+
+        // igraph stores four integers per edge and two per vertex.
+        const double graph_size = (4.0 * g.ecount() + 2.0 * g.vcount()) * sizeof(igraph_integer_t);
+        std::cout << (directed ? "Directed" : "Undirected") << " graph compressed "
+                  << graph_size / cg.memory_size() << " times" << std::endl;
+
+        // Neighbours are decoded in increasing order.
+        for (igraph_integer_t v = 0; v < n; ++v) {
+            for (auto mode : {IGRAPH_OUT, IGRAPH_IN}) {
+                IntVec expected, actual;
+                view(g).for_each_neighbor(v, mode, [&](igraph_integer_t u, igraph_integer_t) {
+                    expected.push_back(u);
+                });
+                cg.for_each_neighbor(v, mode, [&](igraph_integer_t u, igraph_integer_t e) {
+                    actual.push_back(u);
+                    assert(e == -1);
+                });
+                std::sort(expected.begin(), expected.end());
+                assert(actual == expected);
+                assert(cg.degree(v, mode) == expected.size());
+            }
+        }
+
+        // Traversals run directly on the compressed graph.
+        assert(bfs(cg, 0).dist == bfs(g, 0).dist);
+
+        // Decompression gives the same edges, possibly in a different order.
+        assert(edge_list(cg.to_graph()) == edge_list(g));
+
+        // Edge IDs are not available, so algorithms taking edge weights reject it.
+        RealVec weights(cg.ecount());
+        std::fill(weights.begin(), weights.end(), 1);
+        auto rejected = [](void (*f)(const CompressedGraph &, const RealVec &), const CompressedGraph &cg, const RealVec &w) {
+            try {
+                f(cg, w);
+            } catch (const Exception &e) {
+                return e.error == IGRAPH_EINVAL;
+            }
+            return false;
+        };
+        assert(rejected([](const CompressedGraph &cg, const RealVec &w) {
+            RealVec dist;
+            distances_delta_stepping(cg, dist, 0, w);
+        }, cg, weights));
+        assert(rejected([](const CompressedGraph &cg, const RealVec &w) { PowerIteration p(cg, &w); }, cg, weights));
+        assert(rejected([](const CompressedGraph &cg, const RealVec &w) { label_propagation(cg, &w); }, cg, weights));
+        assert(rejected([](const CompressedGraph &cg, const RealVec &w) { NeighborAliasIndex index(cg, &w); }, cg, weights));
+        assert(rejected([](const CompressedGraph &cg, const RealVec &w) { SparseMat a(cg, &w); }, cg, weights));
+        assert(rejected([](const CompressedGraph &cg, const RealVec &w) {
+            RealMat res;
+            distances_floyd_warshall(cg, res, &w);
+        }, cg, weights));
+        assert(rejected([](const CompressedGraph &cg, const RealVec &w) { PowerIteration p(reversed(cg), &w); }, cg, weights));
+    }
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+
+#include <igraph.hpp>
+
+#include <cassert>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::ConnectivityTracker, which keeps the connected
+// components of a graph up to date as edges are added, and its use through
+// ig::DynamicGraph.
+
+// Checks a tracker against the components computed from scratch.
+template<typename G>
+void compare(const ConnectivityTracker &tracker, const G &g) {
+    Components comps = connected_components(g);
+    assert(tracker.count() == comps.count());
+    Components tracked = tracker.components();
+    assert(tracked.membership == comps.membership);
+    assert(tracked.sizes == comps.sizes);
+    for (igraph_integer_t v = 0; v < comps.membership.size(); v += 7) {
+        const igraph_integer_t u = (v * 31) % comps.membership.size();
+        assert(tracker.connected(u, v) == (comps.membership[u] == comps.membership[v]));
+        assert(tracker.component_size(v) == comps.sizes[comps.membership[v]]);
+    }
+}
+
+int main() {
+    RNGScope rng(42);
+
+    const igraph_integer_t n = 2000;
+    igraph_t ig;
+    igraph_erdos_renyi_game_gnm(&ig, n, 500, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    Graph g(Capture(ig));
+
+    // Track a Graph, and record edges as they are added to it.
+    ConnectivityTracker tracker(g);
+    compare(tracker, g);
+    assert(! tracker.update());
+
+    IntVec batch;
+    for (igraph_integer_t i = 0; i < 400; ++i) {
+        batch.push_back(RNG_INTEGER(0, n - 1));
+        batch.push_back(RNG_INTEGER(0, n - 1));
+    }
+    g.add_edges(batch);
+    tracker.add_edges(batch);
+    compare(tracker, g);
+    std::cout << "Components after adding edges: " << tracker.count() << std::endl;
+
+    // The tracker detects other changes of the graph, such as deletions, and rebuilds.
+    IntVec eids;
+    for (igraph_integer_t e = 0; e < g.ecount(); e += 3)
+        eids.push_back(e);
+    g.delete_edges(eids);
+    assert(tracker.update() && ! tracker.update());
+    compare(tracker, g);
+    std::cout << "Components after deleting edges: " << tracker.count() << std::endl;
+
+    // A DynamicGraph updates its tracker as edges are added, and rebuilds it after
+    // edges are deleted.
+    igraph_erdos_renyi_game_gnm(&ig, n, 1500, IGRAPH_DIRECTED, IGRAPH_NO_LOOPS);
+    DynamicGraph dg(Graph(Capture(ig)));
+    dg.track_connectivity();
+    compare(dg.connectivity(), dg);
+
+    for (igraph_integer_t round = 0; round < 5; ++round) {
+        for (igraph_integer_t i = 0; i < 100; ++i)
+            dg.add_edge(RNG_INTEGER(0, n - 1), RNG_INTEGER(0, n - 1));
+        compare(dg.connectivity(), dg);
+
+        for (igraph_integer_t i = 0; i < 50; ++i) {
+            const igraph_integer_t e = RNG_INTEGER(0, dg.ecount() - 1);
+            if (! dg.is_deleted(e))
+                dg.delete_edge(e);
+        }
+        compare(dg.connectivity(), dg);
+    }
+
+    dg.add_vertices(5);
+    dg.add_edge(n, n + 1);
+    const ConnectivityTracker &ct = dg.connectivity();
+    assert(ct.connected(n, n + 1) && ! ct.connected(n, n + 2));
+    assert(ct.component_size(n) == 2);
+    compare(ct, dg);
+    std::cout << "Components of the dynamic graph: " << ct.count() << std::endl;
+
+    return 0;
+}
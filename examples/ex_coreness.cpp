@@ -0,0 +1,37 @@
+
+#include <igraph.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::coreness(), a multi-threaded k-core decomposition.
+
+int main() {
+    RNGScope rng(42);
+
+    igraph_t ig;
+    igraph_erdos_renyi_game_gnm(&ig, 1000, 6000, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    Graph g(Capture(ig));
+
+    IntVec core = coreness(g);
+
+    // Check the result against igraph_coreness().
+    IntVec expected;
+    igraph_coreness(g, expected, IGRAPH_ALL);
+    assert(core == expected);
+
+    const igraph_integer_t degeneracy = *std::max_element(core.begin(), core.end());
+    std::cout << "Degeneracy: " << degeneracy << std::endl;
+
+    // When only the cores up to some k are of interest, peeling can stop early.
+    // Vertices in the k-core are then assigned k.
+    const igraph_integer_t k = degeneracy - 2;
+    IntVec truncated = coreness(g, IGRAPH_ALL, k);
+    for (igraph_integer_t v = 0; v < g.vcount(); ++v)
+        assert(truncated[v] == std::min(core[v], k));
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+
+#include <igraph.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::distances_delta_stepping(), which computes weighted
+// shortest path lengths from a single source using multiple threads.
+
+int main() {
+    RNGScope rng(42);
+
+    igraph_t ig;
+    igraph_erdos_renyi_game_gnm(&ig, 1000, 5000, IGRAPH_DIRECTED, IGRAPH_NO_LOOPS);
+    Graph g(Capture(ig));
+
+    RealVec weights(g.ecount());
+    for (auto &w : weights)
+        w = igraph_rng_get_unif(igraph_rng_default(), 1, 10);
+    // Zero weights are allowed too.
+    for (igraph_integer_t e = 0; e < g.ecount(); e += 10)
+        weights[e] = 0;
+
+    RealVec dist;
+    IntVec pred;
+    distances_delta_stepping(g, dist, 0, weights, &pred);
+
+    // Check the result against igraph_distances_dijkstra().
+    RealMat expected;
+    igraph_distances_dijkstra(g, expected, igraph_vss_1(0), igraph_vss_all(), weights, IGRAPH_OUT);
+    for (igraph_integer_t v = 0; v < g.vcount(); ++v) {
+        assert(std::abs(dist[v] - expected(0, v)) < 1e-9 || dist[v] == expected(0, v));
+        if (v == 0) {
+            assert(pred[v] == -1);
+        } else if (dist[v] == IGRAPH_INFINITY) {
+            assert(pred[v] == -2);
+        } else {
+            // The path to v continues the path to its predecessor.
+            igraph_integer_t eid;
+            igraph_get_eid(g, &eid, pred[v], v, IGRAPH_DIRECTED, true);
+            assert(dist[pred[v]] + weights[eid] == dist[v]);
+        }
+    }
+
+    // Follow predecessors back from vertex 100 to reconstruct a shortest path.
+    std::cout << "Distance from 0 to 100: " << dist[100] << std::endl;
+    std::cout << "Path, from the end:";
+    for (igraph_integer_t v = 100; v >= 0; v = pred[v])
+        std::cout << ' ' << v;
+    std::cout << std::endl;
+
+    return 0;
+}
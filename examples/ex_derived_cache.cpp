@@ -0,0 +1,74 @@
+
+#include <igraph.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::DerivedCache, which memoizes data derived from a graph
+// until the graph changes, as tracked by ig::Graph::version().
+
+int main() {
+    RNGScope rng(42);
+
+    igraph_t ig;
+    igraph_erdos_renyi_game_gnm(&ig, 1000, 3000, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    Graph g(Capture(ig));
+
+    DerivedCache cache(g);
+
+    // The first request computes the result, and later ones reuse it.
+    const IntVec &deg = cache.degree();
+    assert(&cache.degree() == &deg);
+    assert(cache.misses() == 1 && cache.hits() == 1);
+
+    // Different parameters are stored separately.
+    cache.degree(IGRAPH_OUT, false);
+    assert(cache.misses() == 2 && cache.size() == 2);
+
+    const IntVecList &neis = cache.neighbors();
+    for (igraph_integer_t v = 0; v < g.vcount(); ++v)
+        assert(neis[v].size() == deg[v]);
+
+    const Components &comps = cache.components();
+    const IntVec &cores = cache.coreness();
+    assert(cores == coreness(g));
+    const CSRGraph<std::int32_t> &csr = cache.csr();
+    assert(csr.ecount() == g.ecount());
+    assert(&cache.csr() == &csr);
+
+    // Arbitrary results can be cached under a key of their choice.
+    auto max_degree = [](const Graph &g) {
+        IntVec d;
+        igraph_degree(g, d, igraph_vss_all(), IGRAPH_ALL, IGRAPH_LOOPS);
+        return *std::max_element(d.begin(), d.end());
+    };
+    const igraph_integer_t maxdeg = cache.get<igraph_integer_t>("max_degree", max_degree);
+    assert(cache.get<igraph_integer_t>("max_degree", max_degree) == maxdeg);
+    std::cout << "Maximum degree: " << maxdeg << ", components: " << comps.count() << std::endl;
+    std::cout << "Hits: " << cache.hits() << ", misses: " << cache.misses() << std::endl;
+
+    // Modifying the graph drops all stored results.
+    const std::uint64_t version = g.version();
+    g.add_edges({0, 1, 2, 3});
+    assert(g.version() != version);
+
+    const igraph_integer_t misses = cache.misses();
+    const IntVec &deg2 = cache.degree();
+    assert(cache.misses() == misses + 1 && cache.size() == 1);
+    assert(deg2[0] == view(g).degree(0, IGRAPH_ALL));
+
+    g.delete_edges({0});
+    cache.degree();
+    assert(cache.misses() == misses + 2);
+
+    // Changes made through the C API are signalled with invalidate_cache().
+    igraph_add_vertices(g, 3, nullptr);
+    g.invalidate_cache();
+    assert(cache.degree().size() == g.vcount());
+    assert(cache.misses() == misses + 3);
+
+    return 0;
+}
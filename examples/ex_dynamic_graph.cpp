@@ -0,0 +1,163 @@
+
+#include <igraph.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+using namespace ig;
+
+// This example illustrates ig::DynamicGraph, which buffers edge insertions and
+// deletions, and rebuilds the underlying igraph_t only once many have accumulated.
+
+using EdgeList = std::vector<std::pair<igraph_integer_t, igraph_integer_t>>;
+
+// The sorted neighbours of v, in the given mode.
+template<typename G>
+std::vector<igraph_integer_t> neighbors(const G &g, igraph_integer_t v, igraph_neimode_t mode) {
+    std::vector<igraph_integer_t> res;
+    view(g).for_each_neighbor(v, mode, [&](igraph_integer_t u, igraph_integer_t) {
+        res.push_back(u);
+    });
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+// Checks the merged state of 'dg' against a graph built from 'edges'.
+void compare(const DynamicGraph &dg, const EdgeList &edges) {
+    IntVec flat;
+    for (const auto &e : edges) {
+        flat.push_back(e.first);
+        flat.push_back(e.second);
+    }
+    Graph expected(flat, dg.vcount(), dg.is_directed());
+    assert(dg.live_ecount() == expected.ecount());
+    for (igraph_integer_t v = 0; v < dg.vcount(); ++v) {
+        for (igraph_neimode_t mode : {IGRAPH_OUT, IGRAPH_IN, IGRAPH_ALL}) {
+            assert(dg.degree(v, mode) == view(expected).degree(v, mode));
+            assert(neighbors(dg, v, mode) == neighbors(expected, v, mode));
+        }
+    }
+}
+
+int main() {
+    RNGScope rng(42);
+
+    for (bool directed : {true, false}) {
+        igraph_t ig;
+        igraph_erdos_renyi_game_gnm(&ig, 500, 2000, directed, IGRAPH_LOOPS);
+        DynamicGraph dg(Graph(Capture(ig)));
+
+        // The live edges by ID, as a reference.
+        EdgeList edges;
+        std::vector<igraph_integer_t> ids;
+        for (igraph_integer_t e = 0; e < dg.ecount(); ++e) {
+            edges.emplace_back(dg.from(e), dg.to(e));
+            ids.push_back(e);
+        }
+
+        // A stream of random updates, with automatic compaction. Updates that compact
+        // the delta return the new ID of each edge.
+        dg.set_compaction_threshold(0.25);
+        igraph_integer_t compactions = 0;
+        IntVec edge_map;
+        auto remap = [&]() {
+            ++compactions;
+            for (auto &id : ids) {
+                id = edge_map[id];
+                assert(id >= 0);
+            }
+        };
+        for (igraph_integer_t step = 0; step < 3000; ++step) {
+            if (step == 1000)
+                dg.add_vertices(10);
+            const igraph_integer_t before = dg.ecount();
+            if (RNG_UNIF01() < 0.6) {
+                const igraph_integer_t from = RNG_INTEGER(0, dg.vcount() - 1), to = RNG_INTEGER(0, dg.vcount() - 1);
+                const igraph_integer_t e = dg.add_edge(from, to, &edge_map);
+                assert(dg.from(e) == std::max(from, to) || directed);
+                if (! edge_map.empty()) {
+                    assert(edge_map[before] == e);
+                    remap();
+                }
+                edges.emplace_back(dg.from(e), dg.to(e));
+                ids.push_back(e);
+            } else if (! edges.empty()) {
+                const igraph_integer_t i = RNG_INTEGER(0, edges.size() - 1);
+                const igraph_integer_t e = ids[i];
+                edges.erase(edges.begin() + i);
+                ids.erase(ids.begin() + i);
+                if (dg.delete_edge(e, &edge_map)) {
+                    assert(edge_map[e] == -1);
+                    remap();
+                }
+            }
+            if (step % 500 == 0)
+                compare(dg, edges);
+        }
+        std::cout << "Compacted " << compactions << " times." << std::endl;
+        assert(compactions > 0);
+        compare(dg, edges);
+
+        // Algorithms run directly on the merged state.
+        Components comps = connected_components(dg);
+
+        // Explicit compaction, with the mapping of edge IDs.
+        const igraph_integer_t m = dg.ecount();
+        dg.commit(&edge_map);
+        assert(edge_map.size() == m && dg.ecount() == dg.live_ecount());
+        for (igraph_integer_t i = 0; i < igraph_integer_t(ids.size()); ++i) {
+            assert(edge_map[ids[i]] == i);
+            assert(dg.from(i) == edges[i].first && dg.to(i) == edges[i].second);
+        }
+        compare(dg, edges);
+
+        const Graph &g = dg.graph();
+        assert(g.ecount() == igraph_integer_t(edges.size()));
+        assert(connected_components(g).membership == comps.membership);
+    }
+
+    // A batch of deletions is applied as a whole, with IDs referring to the state before
+    // the call, and compaction is considered only once it is complete.
+    IntVec path;
+    for (igraph_integer_t v = 0; v < 2000; ++v) {
+        path.push_back(v);
+        path.push_back(v + 1);
+    }
+    IntVec batch;
+    for (igraph_integer_t e = 1000; e < 1600; ++e)
+        batch.push_back(e);
+
+    for (igraph_real_t threshold : {-1.0, 0.25}) {
+        DynamicGraph dg(Graph(path, 2001, false));
+        dg.set_compaction_threshold(threshold);
+        IntVec edge_map;
+        const bool compacted = dg.delete_edges(batch, &edge_map);
+        assert(dg.live_ecount() == 1400);
+        if (threshold < 0) {
+            // Without automatic compaction, edge IDs do not change.
+            assert(! compacted && edge_map.empty() && dg.ecount() == 2000);
+            for (auto e : batch)
+                assert(dg.is_deleted(e));
+        } else {
+            // 600 deletions exceed a quarter of 2000 edges.
+            assert(compacted && dg.ecount() == 1400 && edge_map.size() == 2000);
+            for (igraph_integer_t e = 0; e < 2000; ++e)
+                assert(edge_map[e] == (e < 1000 ? e : e < 1600 ? -1 : e - 600));
+        }
+        assert(dg.degree(1000) == 1 && dg.degree(1001) == 0 && dg.degree(1600) == 1);
+        assert(connected_components(dg).count() == 601);
+
+        // An invalid ID rejects the whole batch.
+        const igraph_integer_t live = dg.live_ecount();
+        try {
+            dg.delete_edges({0, dg.ecount()});
+            assert(false);
+        } catch (const Exception &) { }
+        assert(dg.live_ecount() == live && ! dg.is_deleted(0));
+    }
+
+    return 0;
+}
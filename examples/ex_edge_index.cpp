@@ -0,0 +1,105 @@
+
+#include <igraph.hpp>
+
+#include <cassert>
+#include <iostream>
+#include <type_traits>
+
+using namespace ig;
+
+// This example illustrates ig::EdgeIndex, a hash table for constant-time edge lookups,
+// as an alternative to igraph_get_eid() when many lookups are made.
+
+void check(const Graph &g, bool bloom_filter) {
+    const igraph_integer_t n = g.vcount();
+    const GraphView gv = view(g);
+    EdgeIndex index(g, bloom_filter);
+    std::cout << "Index of " << g.ecount() << " edges uses " << index.memory_size() << " bytes." << std::endl;
+
+    // Query many random pairs, most of which are not connected.
+    IntVec pairs;
+    for (igraph_integer_t i = 0; i < 20000; ++i) {
+        pairs.push_back(RNG_INTEGER(0, n - 1));
+        pairs.push_back(RNG_INTEGER(0, n - 1));
+    }
+    // And all edges, in both directions.
+    for (igraph_integer_t e = 0; e < g.ecount(); ++e) {
+        pairs.push_back(gv.from(e));
+        pairs.push_back(gv.to(e));
+        pairs.push_back(gv.to(e));
+        pairs.push_back(gv.from(e));
+    }
+
+    for (bool directed : {true, false}) {
+        IntVec eids;
+        index.find(pairs, eids, directed);
+        igraph_integer_t found = 0;
+        for (igraph_integer_t i = 0; i < eids.size(); ++i) {
+            const igraph_integer_t from = pairs[2 * i], to = pairs[2 * i + 1];
+            assert(index.find(from, to, directed) == eids[i]);
+
+            igraph_integer_t expected;
+            igraph_get_eid(g, &expected, from, to, directed, false);
+            assert((eids[i] >= 0) == (expected >= 0));
+            if (eids[i] < 0)
+                continue;
+            ++found;
+
+            // The edge connects the pair, and no edge between them has a smaller ID.
+            const igraph_integer_t f = gv.from(eids[i]), t = gv.to(eids[i]);
+            assert((f == from && t == to) || ((! directed || ! g.is_directed()) && f == to && t == from));
+            for (igraph_integer_t e = 0; e < eids[i]; ++e) {
+                const igraph_integer_t ef = gv.from(e), et = gv.to(e);
+                assert(! (ef == from && et == to));
+                assert((directed && g.is_directed()) || ! (ef == to && et == from));
+            }
+        }
+        std::cout << "Found " << found << " of " << eids.size() << " pairs." << std::endl;
+    }
+}
+
+int main() {
+    RNGScope rng(42);
+
+    for (bool directed : {true, false}) {
+        igraph_t ig;
+        igraph_erdos_renyi_game_gnm(&ig, 1000, 3000, directed, IGRAPH_LOOPS);
+        Graph g(Capture(ig));
+
+        // Duplicate some edges.
+        IntVec edges;
+        igraph_get_edgelist(g, edges, false);
+        for (igraph_integer_t i = 0; i < 200; ++i) {
+            edges.push_back(edges[2 * i]);
+            edges.push_back(edges[2 * i + 1]);
+        }
+        Graph multi(edges, g.vcount(), directed);
+
+        check(multi, false);
+        check(multi, true);
+    }
+
+    // Views must provide edge endpoints, which CSRGraph does not store.
+    static_assert(! std::is_constructible<EdgeIndex, const CSRGraph<std::int32_t> &>::value,
+                  "EdgeIndex requires from() and to().");
+
+    // Undirected queries on directed graphs find the smallest ID in either direction.
+    Graph mutual(IntVec({0, 1, 1, 0, 0, 1}), 2, true);
+    EdgeIndex index(mutual);
+    assert(index.find(0, 1) == 0 && index.find(1, 0) == 1);
+    assert(index.find(1, 0, false) == 0 && index.find(0, 1, false) == 0);
+    Graph mutual2(IntVec({1, 0, 0, 1}), 2, true);
+    assert(EdgeIndex(mutual2).find(0, 1, false) == 0);
+
+    // Deleted edges of a DynamicGraph, and of views of it, are not indexed.
+    DynamicGraph dg(Graph(IntVec({0, 1, 1, 2}), 3, false));
+    const igraph_integer_t added = dg.add_edge(0, 2);
+    dg.add_edge(0, 1);
+    dg.delete_edge(0);
+    dg.delete_edge(added);
+    EdgeIndex dindex(dg);
+    assert(dindex.find(0, 1) == 3 && dindex.find(1, 2) == 1 && ! dindex.contains(0, 2));
+    assert(! EdgeIndex(reversed(dg)).contains(2, 0));
+
+    return 0;
+}
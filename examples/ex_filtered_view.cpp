@@ -0,0 +1,83 @@
+
+#include <igraph.hpp>
+
+#include <cassert>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::FilteredView, which restricts a graph to a subset of its
+// vertices and edges without copying it, and can be passed to the algorithms of
+// igraph-cpp in place of a Graph.
+
+int main() {
+    RNGScope rng(42);
+
+    const igraph_integer_t n = 3000;
+    igraph_t ig;
+    igraph_erdos_renyi_game_gnm(&ig, n, 9000, IGRAPH_DIRECTED, IGRAPH_NO_LOOPS);
+    Graph g(Capture(ig));
+    const igraph_integer_t m = g.ecount();
+
+    // Select two thirds of the vertices, as for a community, and the first half of the
+    // edges, as for a time window.
+    IntVec vids;
+    for (igraph_integer_t v = 0; v < n; ++v)
+        if (v % 3 != 0)
+            vids.push_back(v);
+    Bitset vertices = make_mask(n, vids);
+    Bitset edges(m);
+    for (igraph_integer_t e = 0; e < m / 2; ++e)
+        edges[e] = true;
+
+    // Vertex filter only: the view is the induced subgraph.
+    {
+        FilteredView fv(g, &vertices);
+
+        IntVec ids;
+        Graph sub = fv.materialize(&ids);
+        assert(ids == vids);
+
+        igraph_t ig_sub;
+        igraph_induced_subgraph(g, &ig_sub, igraph_vss_vector(vids), IGRAPH_SUBGRAPH_AUTO);
+        Graph expected(Capture(ig_sub));
+        assert(sub.vcount() == expected.vcount() && sub.ecount() == expected.ecount());
+
+        for (igraph_neimode_t mode : {IGRAPH_OUT, IGRAPH_IN, IGRAPH_ALL}) {
+            IntVec deg;
+            igraph_degree(expected, deg, igraph_vss_all(), mode, IGRAPH_LOOPS);
+            for (igraph_integer_t i = 0; i < vids.size(); ++i)
+                assert(fv.degree(vids[i], mode) == deg[i]);
+            for (igraph_integer_t v = 0; v < n; v += 3)
+                assert(fv.degree(v, mode) == 0);
+        }
+    }
+
+    // Both filters, traversed without copying.
+    FilteredView fv(g, &vertices, &edges);
+    IntVec ids, eids;
+    Graph sub = fv.materialize(&ids, &eids);
+    std::cout << "Subgraph with " << sub.vcount() << " vertices and " << sub.ecount() << " edges." << std::endl;
+    for (igraph_integer_t i = 0; i < eids.size(); ++i)
+        assert(fv.has_edge(eids[i]) && eids[i] < m / 2);
+
+    BFSResult r1 = bfs(fv, {ids[0]}, IGRAPH_OUT);
+    BFSResult r2 = bfs(sub, {0}, IGRAPH_OUT);
+    for (igraph_integer_t i = 0; i < ids.size(); ++i)
+        assert(r1.dist[ids[i]] == r2.dist[i]);
+    for (igraph_integer_t v = 0; v < n; v += 3)
+        assert(r1.dist[v] == -1);
+
+    IntVec c1 = coreness(fv, IGRAPH_ALL);
+    IntVec c2 = coreness(sub, IGRAPH_ALL);
+    for (igraph_integer_t i = 0; i < ids.size(); ++i)
+        assert(c1[ids[i]] == c2[i]);
+
+    // Vertices outside the view are isolated.
+    Components comps1 = connected_components(fv);
+    Components comps2 = connected_components(sub);
+    std::cout << "Number of components in the subgraph: " << comps2.count() << std::endl;
+    assert(comps1.count() == comps2.count() + (n - ids.size()));
+
+    return 0;
+}
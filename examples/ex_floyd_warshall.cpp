@@ -0,0 +1,57 @@
+
+#include <igraph.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::distances_floyd_warshall(), which computes all-pairs
+// shortest path lengths of dense graphs with a blocked Floyd-Warshall algorithm.
+
+int main() {
+    RNGScope rng(42);
+
+    // A dense graph, large enough to span several tiles.
+    igraph_t ig;
+    igraph_erdos_renyi_game_gnp(&ig, 150, 0.2, IGRAPH_DIRECTED, IGRAPH_NO_LOOPS);
+    Graph g(Capture(ig));
+
+    RealVec weights(g.ecount());
+    for (auto &w : weights)
+        w = igraph_rng_get_unif(igraph_rng_default(), 1, 100);
+
+    RealMat dist;
+    distances_floyd_warshall(g, dist, &weights);
+
+    // Check the result against igraph_distances_dijkstra().
+    RealMat expected;
+    igraph_distances_dijkstra(g, expected, igraph_vss_all(), igraph_vss_all(), weights, IGRAPH_OUT);
+    for (igraph_integer_t i = 0; i < g.vcount(); ++i)
+        for (igraph_integer_t j = 0; j < g.vcount(); ++j)
+            assert(std::abs(dist(i, j) - expected(i, j)) < 1e-9 || dist(i, j) == expected(i, j));
+
+    std::cout << "Distance from 0 to 1: " << dist(0, 1) << std::endl;
+
+    // floyd_warshall() works on an existing matrix of edge lengths. Negative lengths
+    // are allowed as long as there are no negative cycles.
+    RealMat lengths = {
+        {0, 4, IGRAPH_INFINITY},
+        {IGRAPH_INFINITY, 0, -2},
+        {1, IGRAPH_INFINITY, 0}
+    };
+    floyd_warshall(lengths);
+    assert(lengths(0, 2) == 2);
+    assert(lengths(2, 1) == 5);
+
+    lengths(2, 0) = -3;
+    try {
+        floyd_warshall(lengths);
+        assert(false);
+    } catch (const Exception &e) {
+        std::cout << "Negative cycle detected." << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+
+#include <igraph.hpp>
+
+#include <cassert>
+#include <functional>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace ig;
+
+// This example illustrates the std::hash specializations of igraph-cpp, which allow
+// graphs and vectors to be stored in unordered containers, and
+// ig::isomorphism_invariant_hash(), which groups graphs that may be isomorphic.
+
+int main() {
+    RNGScope rng(42);
+
+    // Equal vectors have equal hashes, including 0.0 and -0.0.
+    std::hash<RealVec> real_hash;
+    assert(real_hash({1.0, 0.0, 2.5}) == real_hash({1.0, -0.0, 2.5}));
+    assert(real_hash({1.0, 2.0}) != real_hash({2.0, 1.0}));
+
+    std::unordered_set<IntVec> vecs;
+    vecs.insert({1, 2, 3, 4, 5, 6});
+    vecs.insert({1, 2, 3, 4, 5, 6});
+    vecs.insert({1, 2, 3, 4, 5});
+    assert(vecs.size() == 2);
+
+    IntMat mat(2, 3);
+    std::fill(mat.begin(), mat.end(), 7);
+    IntMat mat2 = mat;
+    assert(std::hash<IntMat>()(mat) == std::hash<IntMat>()(mat2));
+
+    IntVecList list, list2;
+    for (IntVecList *l : {&list, &list2}) {
+        l->push_back(IntVec({1, 2}));
+        l->push_back(IntVec({3}));
+    }
+    assert(list == list2 && std::hash<IntVecList>()(list) == std::hash<IntVecList>()(list2));
+
+    // Deduplicate small graphs. Each graph appears three times: as generated, with its
+    // edges in reverse order, which is the same labelled graph, and with its vertices
+    // relabelled, which is an isomorphic graph.
+    const igraph_integer_t count = 300;
+    std::vector<Graph> graphs;
+    for (igraph_integer_t i = 0; i < count; ++i) {
+        igraph_t ig;
+        igraph_erdos_renyi_game_gnm(&ig, 8, 10, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+        Graph g(Capture(ig));
+
+        IntVec edges, reversed_edges;
+        igraph_get_edgelist(g, edges, false);
+        for (igraph_integer_t k = edges.size() - 2; k >= 0; k -= 2) {
+            reversed_edges.push_back(edges[k + 1]);
+            reversed_edges.push_back(edges[k]);
+        }
+
+        IntVec perm({7, 6, 5, 4, 3, 2, 1, 0});
+        graphs.push_back(Graph(reversed_edges, 8, false));
+        graphs.push_back(permute_vertices(g, perm));
+        graphs.push_back(std::move(g));
+    }
+
+    // Hashing is consistent with operator ==.
+    for (igraph_integer_t i = 0; i < count; ++i) {
+        const Graph &a = graphs[3 * i], &b = graphs[3 * i + 2];
+        assert(a == b && std::hash<Graph>()(a) == std::hash<Graph>()(b));
+    }
+
+    std::unordered_set<Graph> unique(graphs.begin(), graphs.end());
+    igraph_integer_t expected = 0;
+    for (std::size_t i = 0; i < graphs.size(); ++i) {
+        bool seen = false;
+        for (std::size_t j = 0; j < i && ! seen; ++j)
+            seen = graphs[i] == graphs[j];
+        expected += ! seen;
+    }
+    std::cout << "Distinct labelled graphs: " << unique.size() << " of " << graphs.size() << std::endl;
+    assert(igraph_integer_t(unique.size()) == expected);
+
+    // Isomorphic graphs share the invariant hash, so they fall in the same group.
+    std::unordered_map<std::uint64_t, igraph_integer_t> groups;
+    for (const auto &g : graphs)
+        groups[isomorphism_invariant_hash(g)]++;
+    for (igraph_integer_t i = 0; i < count; ++i)
+        assert(isomorphism_invariant_hash(graphs[3 * i]) == isomorphism_invariant_hash(graphs[3 * i + 1]));
+    std::cout << "Groups of possibly isomorphic graphs: " << groups.size() << std::endl;
+    assert(igraph_integer_t(groups.size()) <= count);
+
+    // Directed graphs: the hash distinguishes edge directions.
+    Graph path(IntVec({0, 1, 1, 2}), 3, true);
+    Graph star(IntVec({1, 0, 1, 2}), 3, true);
+    assert(isomorphism_invariant_hash(path) != isomorphism_invariant_hash(star));
+    assert(isomorphism_invariant_hash(path) == isomorphism_invariant_hash(Graph(IntVec({2, 0, 0, 1}), 3, true)));
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <igraph.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::hyperball(), which estimates the number of pairs of
+// vertices within each distance, and related per-vertex statistics, with HyperLogLog
+// counters instead of a breadth-first search from every vertex.
+
+int main() {
+    RNGScope rng(42);
+
+    igraph_t ig;
+    igraph_erdos_renyi_game_gnm(&ig, 2000, 3000, IGRAPH_DIRECTED, IGRAPH_NO_LOOPS);
+    Graph g(Capture(ig));
+
+    HyperBallResult hb = hyperball(g, 10);
+
+    // Compare with the exact values computed from all shortest path lengths.
+    RealMat dist;
+    igraph_distances(g, dist, igraph_vss_all(), igraph_vss_all(), IGRAPH_OUT);
+
+    RealVec pairs(hb.pairs.size());
+    RealVec harmonic(g.vcount());
+    for (igraph_integer_t v = 0; v < g.vcount(); ++v) {
+        for (igraph_integer_t u = 0; u < g.vcount(); ++u) {
+            const igraph_real_t d = dist(v, u);
+            if (d == IGRAPH_INFINITY)
+                continue;
+            // HyperBall stops once no counter changes, which may happen before balls
+            // stop growing, so its last round stands for all larger distances.
+            const igraph_integer_t last = pairs.size() - 1;
+            for (igraph_integer_t t = std::min(igraph_integer_t(d), last); t <= last; ++t)
+                pairs[t] += 1;
+            if (u != v)
+                harmonic[v] += 1 / d;
+        }
+    }
+
+    // With 2^10 registers per counter, the relative error is about 3%. The errors of
+    // vertices with similar balls are correlated, so they do not average out.
+    for (igraph_integer_t t = 0; t < pairs.size(); ++t)
+        assert(std::abs(hb.pairs[t] / pairs[t] - 1) < 0.1);
+
+    igraph_real_t total = 0, total_estimate = 0;
+    for (igraph_integer_t v = 0; v < g.vcount(); ++v) {
+        total += harmonic[v];
+        total_estimate += hb.harmonic[v];
+    }
+    assert(std::abs(total_estimate / total - 1) < 0.1);
+
+    std::cout << "Estimated effective diameter: " << effective_diameter(hb.pairs) << std::endl;
+    std::cout << "Exact effective diameter:     " << effective_diameter(pairs) << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+
+#include <igraph.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::pagerank_update(), which updates PageRank scores
+// after a batch of edge changes, without recomputing them from scratch.
+
+int main() {
+    RNGScope rng(42);
+
+    igraph_t ig;
+    igraph_erdos_renyi_game_gnm(&ig, 2000, 10000, IGRAPH_DIRECTED, IGRAPH_NO_LOOPS);
+    Graph g(Capture(ig));
+
+    RealVec rank;
+    PowerIteration pi(g);
+    pi.set_tolerance(1e-14);
+    pi.pagerank(rank, 0.85);
+
+    // Remove the first 20 edges, and insert 20 random new ones.
+    IntVec remove, insert;
+    for (igraph_integer_t e = 0; e < 20; ++e) {
+        igraph_integer_t from, to;
+        igraph_edge(g, e, &from, &to);
+        remove.push_back(from);
+        remove.push_back(to);
+    }
+    for (igraph_integer_t i = 0; i < 40; ++i)
+        insert.push_back(RNG_INTEGER(0, g.vcount() - 1));
+
+    const std::uint64_t version = g.version();
+    igraph_integer_t pushes = pagerank_update(g, rank, insert, remove, 0.85, 1e-12);
+    std::cout << "Updated PageRank with " << pushes << " pushes." << std::endl;
+    assert(g.ecount() == 10000 && g.version() != version);
+
+    // Compare with PageRank recomputed on the modified graph.
+    RealVec expected;
+    PowerIteration updated(g);
+    updated.set_tolerance(1e-14);
+    updated.pagerank(expected, 0.85);
+    for (igraph_integer_t v = 0; v < g.vcount(); ++v)
+        assert(std::abs(rank[v] - expected[v]) < 1e-9);
+
+    // Invalid input leaves both the graph and the ranks unchanged.
+    const RealVec before = rank;
+    const igraph_integer_t m = g.ecount();
+    igraph_integer_t from, to;
+    igraph_edge(g, 0, &from, &to);
+    try {
+        pagerank_update(g, rank, IntVec({0, g.vcount()}), IntVec({from, to}));
+        assert(false);
+    } catch (const Exception &e) {
+        assert(e.error == IGRAPH_EINVVID);
+    }
+    assert(g.ecount() == m && rank == before);
+
+    return 0;
+}
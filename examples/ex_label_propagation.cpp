@@ -0,0 +1,48 @@
+#include <igraph.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::label_propagation(), a multi-threaded community
+// detection method, and its deterministic mode.
+
+int main() {
+    RNGScope rng(42);
+
+    // A graph with 10 groups of 100 vertices, which are densely connected within
+    // groups, and sparsely between them.
+    const igraph_integer_t groups = 10, size = 100;
+    IntVec edges;
+    for (igraph_integer_t i = 0; i < 8000; ++i) {
+        const igraph_integer_t group = RNG_INTEGER(0, groups - 1);
+        edges.push_back(group * size + RNG_INTEGER(0, size - 1));
+        edges.push_back(group * size + RNG_INTEGER(0, size - 1));
+    }
+    for (igraph_integer_t i = 0; i < 100; ++i) {
+        edges.push_back(RNG_INTEGER(0, groups * size - 1));
+        edges.push_back(RNG_INTEGER(0, groups * size - 1));
+    }
+    Graph g(edges, groups * size);
+
+    IntVec membership = label_propagation(g);
+    const igraph_integer_t count = *std::max_element(membership.begin(), membership.end()) + 1;
+    std::cout << "Communities: " << count << std::endl;
+
+    // Within each group, vertices share their community.
+    for (igraph_integer_t v = 0; v < g.vcount(); ++v)
+        assert(membership[v] == membership[v - v % size]);
+
+    // In deterministic mode, the result depends only on the random seed,
+    // even with a different number of threads.
+    auto run = [&](unsigned threads) {
+        RNGScope rng(123);
+        set_thread_count(threads);
+        return label_propagation(g, nullptr, IGRAPH_ALL, true);
+    };
+    assert(run(1) == run(4));
+
+    return 0;
+}
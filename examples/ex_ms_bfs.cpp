@@ -0,0 +1,57 @@
+
+#include <igraph.hpp>
+#include "ex_vector_print.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::multi_source_distances() and ig::multi_source_bfs(),
+// which compute hop distances from many sources at once using bit-parallel BFS.
+
+int main() {
+    RNGScope rng(42);
+
+    igraph_t ig;
+    igraph_erdos_renyi_game_gnm(&ig, 500, 1000, IGRAPH_DIRECTED, IGRAPH_NO_LOOPS);
+    Graph g(Capture(ig));
+
+    // Use 300 "landmark" vertices, which are processed in two batches.
+    IntVec landmarks(300);
+    for (igraph_integer_t i = 0; i < landmarks.size(); ++i)
+        landmarks[i] = (7 * i) % g.vcount();
+
+    // Row i of 'dist' holds the distances from landmarks[i]. Unreachable vertices
+    // are marked with -1.
+    IntMat dist;
+    multi_source_distances(g, landmarks, dist, IGRAPH_OUT);
+    std::cout << "Distances from vertex " << landmarks[1] << " to the first 10 vertices:";
+    for (igraph_integer_t v = 0; v < 10; ++v)
+        std::cout << ' ' << dist(1, v);
+    std::cout << std::endl;
+
+    // Check the result against igraph_distances().
+    RealMat expected;
+    igraph_distances(g, expected, igraph_vss_vector(landmarks), igraph_vss_all(), IGRAPH_OUT);
+    for (igraph_integer_t i = 0; i < dist.nrow(); ++i)
+        for (igraph_integer_t v = 0; v < dist.ncol(); ++v)
+            assert(std::isfinite(expected(i, v)) ? dist(i, v) == expected(i, v) : dist(i, v) == -1);
+
+    // When the full matrix does not fit in memory, distances can be streamed instead.
+    // Here we compute the eccentricity of each landmark, ignoring unreachable vertices.
+    IntVec eccentricity(landmarks.size());
+    multi_source_bfs(g, landmarks, [&](igraph_integer_t i, const IntVec &d) {
+        eccentricity[i] = *std::max_element(d.begin(), d.end());
+        for (igraph_integer_t v = 0; v < d.size(); ++v)
+            assert(d[v] == dist(i, v));
+    }, IGRAPH_OUT);
+    std::cout << "Eccentricities of the first 10 landmarks:";
+    for (igraph_integer_t i = 0; i < 10; ++i)
+        std::cout << ' ' << eccentricity[i];
+    std::cout << std::endl;
+
+    return 0;
+}
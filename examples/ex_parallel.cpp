@@ -0,0 +1,58 @@
+
+#include <igraph.hpp>
+
+#include <cassert>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::parallel_transform(), which applies a function
+// to each graph in a GraphList using multiple threads.
+
+int main() {
+    // Parallel routines use std::thread::hardware_concurrency() threads by default.
+    // Here we request a fixed number of threads instead.
+    set_thread_count(4);
+
+    RNGScope rng(42);
+
+    // A sparse random graph has one large component and many small ones.
+    igraph_t ig;
+    igraph_erdos_renyi_game_gnm(&ig, 300, 200, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    Graph g(Capture(ig));
+
+    // Decompose it into its components, ignoring isolated vertices.
+    GraphList components;
+    igraph_decompose(g, components, IGRAPH_WEAK, -1, 2);
+
+    // Scalar results are collected into a Vec of the matching type. The components
+    // are processed from largest to smallest, but the results are in list order.
+    RealVec diameters = parallel_transform(components, [](const Graph &c) {
+        igraph_real_t diameter;
+        check(igraph_diameter(c, &diameter, nullptr, nullptr, nullptr, nullptr, IGRAPH_UNDIRECTED, true));
+        return diameter;
+    });
+
+    // Vec results are collected into a VecList.
+    IntVecList degrees = parallel_transform(components, [](const Graph &c) {
+        IntVec deg;
+        check(igraph_degree(c, deg, igraph_vss_all(), IGRAPH_ALL, IGRAPH_LOOPS));
+        return deg;
+    });
+
+    assert(diameters.size() == components.size());
+    assert(degrees.size() == components.size());
+
+    igraph_integer_t largest = 0;
+    for (igraph_integer_t i = 0; i < components.size(); ++i) {
+        assert(degrees[i].size() == components[i].vcount());
+        if (components[i].vcount() > components[largest].vcount())
+            largest = i;
+    }
+
+    std::cout << "Number of non-trivial components: " << components.size() << std::endl;
+    std::cout << "Size of the largest component: " << components[largest].vcount() << std::endl;
+    std::cout << "Diameter of the largest component: " << diameters[largest] << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+
+#include <igraph.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::PowerIteration, which computes PageRank and
+// eigenvector centrality using multi-threaded sparse matrix-vector products.
+
+bool approx_equal(const RealVec &a, const RealVec &b, igraph_real_t eps) {
+    if (a.size() != b.size())
+        return false;
+    for (igraph_integer_t i = 0; i < a.size(); ++i)
+        if (std::abs(a[i] - b[i]) > eps)
+            return false;
+    return true;
+}
+
+int main() {
+    RNGScope rng(42);
+
+    igraph_t ig;
+    igraph_erdos_renyi_game_gnm(&ig, 1000, 5000, IGRAPH_DIRECTED, IGRAPH_NO_LOOPS);
+    Graph g(Capture(ig));
+
+    RealVec weights(g.ecount());
+    for (auto &w : weights)
+        w = igraph_rng_get_unif(igraph_rng_default(), 1, 2);
+
+    // The graph is converted to a compressed format once, and can then be used
+    // for several computations.
+    PowerIteration pi(g, &weights);
+
+    RealVec rank, expected;
+    igraph_integer_t iterations = pi.pagerank(rank, 0.85);
+    igraph_pagerank(g, IGRAPH_PAGERANK_ALGO_PRPACK, expected, nullptr, igraph_vss_all(), IGRAPH_DIRECTED, 0.85, weights, nullptr);
+    assert(approx_equal(rank, expected, 1e-9));
+    std::cout << "PageRank converged in " << iterations << " iterations." << std::endl;
+
+    // Personalized PageRank, with random jumps to the first ten vertices only.
+    RealVec reset(g.vcount());
+    for (igraph_integer_t v = 0; v < 10; ++v)
+        reset[v] = 1;
+    RealVec personalized;
+    pi.pagerank(personalized, 0.85, &reset);
+    igraph_personalized_pagerank(g, IGRAPH_PAGERANK_ALGO_PRPACK, expected, nullptr, igraph_vss_all(), IGRAPH_DIRECTED, 0.85, reset, weights, nullptr);
+    assert(approx_equal(personalized, expected, 1e-9));
+
+    // When the graph changes slightly, starting from the previous result
+    // takes fewer iterations.
+    IntVec new_edges = {0, 1, 2, 3, 4, 5};
+    igraph_add_edges(g, new_edges, nullptr);
+    weights.push_back(1);
+    weights.push_back(1);
+    weights.push_back(1);
+
+    PowerIteration updated(g, &weights);
+    igraph_integer_t warm_iterations = updated.pagerank(rank, 0.85, nullptr, true);
+    std::cout << "After adding edges, PageRank converged in " << warm_iterations
+              << " iterations from the previous result." << std::endl;
+    assert(warm_iterations < iterations);
+
+    // Eigenvector centrality of an undirected graph.
+    igraph_t ug;
+    igraph_erdos_renyi_game_gnm(&ug, 500, 3000, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    Graph u(Capture(ug));
+
+    RealVec centrality;
+    igraph_real_t value, expected_value;
+    PowerIteration(u).eigenvector_centrality(centrality, &value);
+    igraph_eigenvector_centrality(u, expected, &expected_value, IGRAPH_UNDIRECTED, true, nullptr, nullptr);
+    assert(approx_equal(centrality, expected, 1e-6));
+    assert(std::abs(value - expected_value) < 1e-6);
+    std::cout << "Largest eigenvalue: " << value << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <igraph.hpp>
+
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::RandomWalker, which generates many random walks
+// in parallel, for example to train vertex embeddings.
+
+int main() {
+    RNGScope rng(42);
+
+    igraph_t ig;
+    igraph_erdos_renyi_game_gnm(&ig, 1000, 5000, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    Graph g(Capture(ig));
+
+    // Ten walks of 20 vertices from each vertex.
+    IntVec starts;
+    for (igraph_integer_t i = 0; i < 10; ++i)
+        for (igraph_integer_t v = 0; v < g.vcount(); ++v)
+            starts.push_back(v);
+    const igraph_integer_t length = 20;
+
+    RandomWalker walker(g);
+    IntMat walks = walker.walks(starts, length);
+
+    // Each column is a walk. Vertices without neighbours end their walks early.
+    for (igraph_integer_t j = 0; j < walks.ncol(); ++j) {
+        assert(walks(0, j) == starts[j]);
+        for (igraph_integer_t i = 1; i < length && walks(i, j) >= 0; ++i) {
+            igraph_bool_t adjacent;
+            igraph_are_adjacent(g, walks(i - 1, j), walks(i, j), &adjacent);
+            assert(adjacent);
+        }
+    }
+
+    // Weighted walks never follow edges of zero weight.
+    RealVec weights(g.ecount());
+    for (igraph_integer_t e = 0; e < g.ecount(); ++e)
+        weights[e] = e % 2;
+    RandomWalker weighted(g, &weights);
+    IntMat wwalks = weighted.walks(starts, length);
+    for (igraph_integer_t j = 0; j < wwalks.ncol(); ++j) {
+        for (igraph_integer_t i = 1; i < length && wwalks(i, j) >= 0; ++i) {
+            igraph_integer_t eid;
+            igraph_get_eid(g, &eid, wwalks(i - 1, j), wwalks(i, j), IGRAPH_UNDIRECTED, true);
+            assert(weights[eid] == 1);
+        }
+    }
+
+    // node2vec walks with a small return parameter p tend to step back and forth.
+    RandomWalker biased(g);
+    biased.set_node2vec(0.01, 1);
+    IntMat bwalks = biased.walks(starts, length);
+    igraph_integer_t returns = 0, steps = 0;
+    for (igraph_integer_t j = 0; j < bwalks.ncol(); ++j) {
+        for (igraph_integer_t i = 2; i < length && bwalks(i, j) >= 0; ++i) {
+            returns += bwalks(i, j) == bwalks(i - 2, j);
+            steps++;
+        }
+    }
+    std::cout << "Fraction of node2vec steps returning: " << double(returns) / steps << std::endl;
+    assert(returns > 0.8 * steps);
+
+    // Walks are reproducible with the same seed, regardless of the number of threads,
+    // and can be generated in chunks when they do not fit in memory.
+    set_thread_count(1);
+    IntMat walks1 = [&] { RNGScope rng(123); return walker.walks(starts, length); }();
+    set_thread_count(4);
+    IntMat walks2 = [&] { RNGScope rng(123); return walker.walks(starts, length); }();
+    assert(walks1 == walks2);
+
+    {
+        RNGScope rng(123);
+        walker.for_each_chunk(starts, length, [&](const IntMat &chunk, igraph_integer_t first) {
+            for (igraph_integer_t j = 0; j < chunk.ncol(); ++j)
+                for (igraph_integer_t i = 0; i < length; ++i)
+                    assert(chunk(i, j) == walks1(i, first + j));
+        }, 1000);
+    }
+
+    // Walks can also be written directly to a file, one per line.
+    std::FILE *file = std::tmpfile();
+    walker.write(file, starts, length);
+    std::rewind(file);
+    igraph_integer_t lines = 0;
+    for (int c; (c = std::fgetc(file)) != EOF; )
+        lines += c == '\n';
+    std::fclose(file);
+    assert(lines == starts.size());
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <igraph.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::reorder(), which relabels vertices so that
+// neighbours get nearby IDs, for faster traversals.
+
+// The largest difference between the IDs of adjacent vertices.
+igraph_integer_t bandwidth(const Graph &g) {
+    igraph_integer_t res = 0;
+    for (igraph_integer_t e = 0; e < g.ecount(); ++e) {
+        igraph_integer_t from, to;
+        igraph_edge(g, e, &from, &to);
+        res = std::max(res, std::abs(from - to));
+    }
+    return res;
+}
+
+int main() {
+    RNGScope rng(42);
+
+    // A 30 x 30 grid with randomly assigned vertex IDs.
+    const igraph_integer_t size = 30, n = size * size;
+    IntVec ids(n);
+    for (igraph_integer_t v = 0; v < n; ++v)
+        ids[v] = v;
+    for (igraph_integer_t v = n - 1; v > 0; --v)
+        std::swap(ids[v], ids[RNG_INTEGER(0, v)]);
+
+    IntVec edges;
+    for (igraph_integer_t i = 0; i < size; ++i) {
+        for (igraph_integer_t j = 0; j < size; ++j) {
+            if (i + 1 < size) {
+                edges.push_back(ids[i * size + j]);
+                edges.push_back(ids[(i + 1) * size + j]);
+            }
+            if (j + 1 < size) {
+                edges.push_back(ids[i * size + j]);
+                edges.push_back(ids[i * size + j + 1]);
+            }
+        }
+    }
+    Graph g(edges, n);
+
+    // A vertex attribute: the row of each vertex in the grid.
+    RealVec row(n);
+    for (igraph_integer_t v = 0; v < n; ++v)
+        row[ids[v]] = v / size;
+
+    std::cout << "Bandwidth before reordering: " << bandwidth(g) << std::endl;
+
+    // Reverse Cuthill-McKee brings the bandwidth close to the optimum, the grid size.
+    ReorderResult rcm = reorder(g, ReorderMethod::RCM);
+    std::cout << "Bandwidth after RCM: " << bandwidth(rcm.graph) << std::endl;
+    assert(bandwidth(rcm.graph) <= 2 * size);
+
+    for (auto method : {ReorderMethod::Degree, ReorderMethod::BFS, ReorderMethod::RCM, ReorderMethod::Gorder}) {
+        ReorderResult res = reorder(g, method);
+
+        // The result is a permutation, and edge e connects the relabelled endpoints.
+        IntVec sorted = res.permutation;
+        std::sort(sorted.begin(), sorted.end());
+        for (igraph_integer_t v = 0; v < n; ++v)
+            assert(sorted[v] == v);
+        for (igraph_integer_t e = 0; e < g.ecount(); ++e) {
+            igraph_integer_t from, to, new_from, new_to;
+            igraph_edge(g, e, &from, &to);
+            igraph_edge(res.graph, e, &new_from, &new_to);
+            assert(std::minmax(new_from, new_to) == std::minmax(res.permutation[from], res.permutation[to]));
+        }
+
+        // Vertex attributes are carried over with permute_values().
+        RealVec new_row = permute_values(row, res.permutation);
+        for (igraph_integer_t v = 0; v < n; ++v)
+            assert(new_row[res.permutation[v]] == row[v]);
+    }
+
+    return 0;
+}
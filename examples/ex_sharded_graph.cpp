@@ -0,0 +1,145 @@
+
+#include <igraph.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace ig;
+
+// This example illustrates ig::ShardedGraph, which stores the edges of a graph in
+// files on disk, and processes them one shard at a time, for graphs that do not fit
+// in memory. Vertex state can be kept in files as well, with ig::MappedVec.
+
+// Checks the kernels of a sharded graph against the in-memory results for 'g'.
+void compare(const ShardedGraph &sg, const Graph &g) {
+    const igraph_integer_t n = g.vcount();
+
+    for (igraph_neimode_t mode : {IGRAPH_OUT, IGRAPH_IN, IGRAPH_ALL}) {
+        IntVec deg(n), expected;
+        sg.degree(deg, mode);
+        igraph_degree(g, expected, igraph_vss_all(), mode, IGRAPH_LOOPS);
+        assert(deg == expected);
+    }
+
+    // Vertex state may live in a file that is mapped into memory.
+    MappedVec<igraph_real_t> rank("ex_sharded_graph.rank", n, true);
+    const igraph_integer_t iterations = sg.pagerank(rank.vec(), 0.85, 1e-12);
+    std::cout << "PageRank converged after " << iterations << " iterations." << std::endl;
+
+    PowerIteration pi(g);
+    pi.set_tolerance(1e-12);
+    RealVec expected;
+    pi.pagerank(expected);
+    for (igraph_integer_t v = 0; v < n; ++v)
+        assert(std::abs(rank.vec()[v] - expected[v]) < 1e-9);
+
+    IntVec membership(n);
+    const igraph_integer_t count = sg.connected_components(membership);
+    std::cout << "Number of components: " << count << std::endl;
+
+    Components comps = connected_components(g);
+    assert(count == comps.count());
+    assert(membership == comps.membership);
+}
+
+int main() {
+    RNGScope rng(42);
+
+    for (bool directed : {true, false}) {
+        const igraph_integer_t n = 5000;
+        igraph_t ig;
+        igraph_erdos_renyi_game_gnm(&ig, n, 4000, directed, IGRAPH_NO_LOOPS);
+        Graph g(Capture(ig));
+
+        // Add a self-loop, then split the edges among 7 shards.
+        IntVec edges;
+        igraph_get_edgelist(g, edges, false);
+        edges.push_back(3);
+        edges.push_back(3);
+        Graph g2(edges, n, directed);
+
+        ShardedGraph sg("ex_sharded_graph", n, directed, 7);
+        sg.add_edges(edges);
+        sg.finish();
+        assert(sg.vcount() == n && sg.ecount() == g2.ecount());
+        assert(sg.shard_count() == 7);
+
+        compare(sg, g2);
+    }
+
+    // Edges can also be read from an edge list file, without loading it into memory.
+    {
+        std::FILE *file = std::tmpfile();
+        assert(file);
+        std::fputs("0 1\n1 2\n\n 2   0\n3 4\r\n5 5\n6 7", file);
+        std::rewind(file);
+
+        ShardedGraph sg("ex_sharded_graph", 8, false, 3);
+        sg.add_edges(file);
+        std::fclose(file);
+        sg.finish();
+        assert(sg.ecount() == 6);
+
+        IntVec membership(8);
+        assert(sg.connected_components(membership) == 4);
+        assert(membership == IntVec({0, 0, 0, 1, 1, 2, 3, 3}));
+
+        IntVec deg(8);
+        sg.degree(deg);
+        assert(deg == IntVec({2, 2, 2, 1, 1, 2, 1, 1}));
+    }
+
+    // Malformed input is reported as a parse error.
+    {
+        std::FILE *file = std::tmpfile();
+        assert(file);
+        std::fputs("0 1\n1 x\n", file);
+        std::rewind(file);
+
+        ShardedGraph sg("ex_sharded_graph", 2, false, 1);
+        bool caught = false;
+        try {
+            sg.add_edges(file);
+        } catch (const Exception &e) {
+            caught = e.error == IGRAPH_PARSEERROR;
+        }
+        std::fclose(file);
+        assert(caught);
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    // If a shard file cannot be created, here because a directory has its name, only the
+    // files created so far are removed. Other files sharing the prefix are left alone.
+    {
+        const char *blocked = "ex_sharded_graph_fail.fwd.1", *other = "ex_sharded_graph_fail.fwd.2";
+        assert(mkdir(blocked, 0755) == 0);
+        std::FILE *f = std::fopen(other, "w");
+        assert(f);
+        std::fclose(f);
+
+        bool caught = false;
+        try {
+            ShardedGraph sg("ex_sharded_graph_fail", 30, false, 3);
+        } catch (const Exception &e) {
+            caught = e.error == IGRAPH_EFILE;
+        }
+        assert(caught);
+
+        f = std::fopen(other, "r");
+        assert(f);
+        std::fclose(f);
+        assert(! std::fopen("ex_sharded_graph_fail.fwd.0", "r"));
+        std::remove(other);
+        rmdir(blocked);
+    }
+#endif
+
+    return 0;
+}
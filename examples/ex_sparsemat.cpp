@@ -0,0 +1,83 @@
+
+#include <igraph.hpp>
+
+#include <cassert>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::SparseMat, a wrapper for igraph_sparsemat_t,
+// and ig::CSRMat, which computes sparse matrix products using multiple threads.
+
+int main() {
+    // Matrices are created in triplet form, and entries are added one by one.
+    SparseMat a(3, 4);
+    a.add(0, 0, 1);
+    a.add(1, 2, 2);
+    a.add(2, 3, 3);
+    a.add(2, 1, 4);
+    assert(a.is_triplet());
+    assert(a.nonzeros() == 4);
+
+    // Most operations need the column-compressed form.
+    SparseMat cc = a.compress();
+    assert(cc.is_cc());
+    assert(cc(2, 1) == 4);
+    assert(cc(0, 1) == 0);
+
+    SparseMat t = cc.transpose();
+    assert(t.nrow() == 4 && t.ncol() == 3);
+    assert(t(1, 2) == 4);
+
+    // Conversion to compressed sparse row form.
+    IntVec ptrs, index;
+    RealVec values;
+    cc.to_csr(ptrs, index, values);
+    assert((ptrs == IntVec{0, 1, 2, 4}));
+    assert((index == IntVec{0, 2, 1, 3}));
+    assert((values == RealVec{1, 2, 4, 3}));
+
+    RealVec x = {1, 1, 1, 1}, y;
+    cc.multiply(x, y);
+    assert((y == RealVec{1, 2, 7}));
+
+    // The adjacency matrix of a graph can be created directly.
+    Graph g(IntVec{0, 1, 1, 2, 2, 3, 3, 0}, 4, IGRAPH_UNDIRECTED);
+    SparseMat adj(g);
+    assert(adj(0, 1) == 1 && adj(1, 0) == 1 && adj(0, 2) == 0);
+
+    // For repeated products with the same matrix, convert it once.
+    CSRMat csr(adj);
+    RealMat block = {{1, 0}, {0, 0}, {0, 0}, {0, 1}};
+    RealMat res;
+    csr.multiply(block, res);
+    assert(res.nrow() == 4 && res.ncol() == 2);
+    assert(res(1, 0) == 1 && res(3, 0) == 1 && res(0, 1) == 1 && res(2, 1) == 1);
+    assert(res(0, 0) == 0 && res(3, 1) == 0);
+
+    // Multiplying by the all-ones vector gives the degrees.
+    RealVec ones = {1, 1, 1, 1}, degrees;
+    csr.multiply(ones, degrees);
+    std::cout << "Degrees:";
+    for (auto d : degrees)
+        std::cout << ' ' << d;
+    std::cout << std::endl;
+
+    // The input may also receive the result.
+    RealVec walk = {1, 0, 0, 0};
+    csr.multiply(walk, walk);
+    csr.multiply(walk, walk);
+    assert((walk == RealVec{2, 0, 2, 0}));
+    csr.multiply(block, block);
+    assert(block == res);
+
+    // The length of x must match the number of columns.
+    try {
+        csr.multiply(RealVec{1, 1}, y);
+        assert(false);
+    } catch (const Exception &e) {
+        assert(e.error == IGRAPH_EINVAL);
+    }
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+
+#include <igraph.hpp>
+
+#include <cassert>
+#include <iostream>
+
+using namespace ig;
+
+// This example illustrates ig::reversed() and ig::as_undirected(), which view a
+// directed graph with its edges reversed, or with edge directions ignored, without
+// copying it.
+
+int main() {
+    RNGScope rng(42);
+
+    const igraph_integer_t n = 2000;
+    igraph_t ig;
+    igraph_erdos_renyi_game_gnm(&ig, n, 6000, IGRAPH_DIRECTED, IGRAPH_LOOPS);
+    Graph g(Capture(ig));
+
+    // The same graphs, built explicitly.
+    IntVec edges, swapped;
+    igraph_get_edgelist(g, edges, false);
+    for (igraph_integer_t i = 0; i < edges.size(); i += 2) {
+        swapped.push_back(edges[i + 1]);
+        swapped.push_back(edges[i]);
+    }
+    Graph transpose(swapped, n, true);
+    Graph undirected(edges, n, false);
+
+    auto rg = reversed(g);
+    auto ug = as_undirected(g);
+    assert(rg.is_directed() && ! ug.is_directed());
+
+    // Converting a view to a CSRGraph copies it: edge IDs are preserved.
+    CSRGraph<std::int32_t> csr(rg);
+    IntVec result;
+    igraph_get_edgelist(csr.to_graph(), result, false);
+    assert(result == swapped);
+
+    for (igraph_integer_t v = 0; v < n; ++v) {
+        for (igraph_neimode_t mode : {IGRAPH_OUT, IGRAPH_IN, IGRAPH_ALL}) {
+            assert(rg.degree(v, mode) == view(transpose).degree(v, mode));
+            assert(ug.degree(v, mode) == view(undirected).degree(v, mode));
+        }
+    }
+
+    // Distances to a vertex are distances from it in the transpose.
+    BFSResult r1 = bfs(rg, {0}, IGRAPH_OUT);
+    BFSResult r2 = bfs(g, {0}, IGRAPH_IN);
+    BFSResult r3 = bfs(transpose, {0}, IGRAPH_OUT);
+    assert(r1.dist == r2.dist && r1.dist == r3.dist);
+
+    IntVec c1 = coreness(ug);
+    IntVec c2 = coreness(undirected);
+    assert(c1 == c2);
+
+    // Adaptors compose with other views.
+    IntVec vids;
+    for (igraph_integer_t v = 0; v < n; v += 2)
+        vids.push_back(v);
+    Bitset mask = make_mask(n, vids);
+    FilteredView fv(g, &mask);
+    auto rfv = reversed(fv);
+    for (igraph_integer_t v = 0; v < n; ++v)
+        assert(rfv.degree(v, IGRAPH_OUT) == fv.degree(v, IGRAPH_IN));
+
+    Components comps = connected_components(as_undirected(rfv));
+    std::cout << "Number of components: " << comps.count() << std::endl;
+    assert(comps.membership == connected_components(fv).membership);
+
+    return 0;
+}
@@ -0,0 +1,227 @@
+
+// Weighted sampling with alias tables.
+//
+// An alias table (Vose's method) samples from a discrete distribution over n items in
+// constant time, after O(n) preprocessing: pick a slot i uniformly, then return i with
+// probability 'prob[i]' and 'alias[i]' otherwise. AliasTable samples from a single
+// distribution, such as vertex or edge weights. NeighborAliasIndex holds one table per
+// vertex, built once from the edge weights, for sampling weighted neighbours.
+//
+// Sampling functions take a random number generator with integer(n) and unif01()
+// member functions, such as RNGStream. Without one, they use igraph's default
+// generator, which must not be used from multiple threads at once.
+
+namespace detail {
+
+// Builds an alias table for sampling from [0, k), k > 0, with probabilities proportional
+// to the non-negative weights w, whose sum must be positive. 'small' and 'large' are
+// working space.
+inline void build_alias_table(const igraph_real_t *w, igraph_integer_t k,
+                              igraph_real_t *prob, igraph_integer_t *alias,
+                              std::vector<igraph_integer_t> &small, std::vector<igraph_integer_t> &large) {
+    const igraph_real_t total = std::accumulate(w, w + k, igraph_real_t(0));
+    small.clear();
+    large.clear();
+    for (igraph_integer_t i = 0; i < k; ++i) {
+        prob[i] = w[i] * k / total;
+        alias[i] = i;
+        (prob[i] < 1 ? small : large).push_back(i);
+    }
+    while (! small.empty() && ! large.empty()) {
+        const igraph_integer_t s = small.back(), l = large.back();
+        small.pop_back();
+        alias[s] = l;
+        prob[l] -= 1 - prob[s];
+        if (prob[l] < 1) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // Whatever remains is 1 up to rounding errors.
+    for (auto i : small)
+        prob[i] = 1;
+    for (auto i : large)
+        prob[i] = 1;
+}
+
+// Draws from igraph's default random number generator.
+struct DefaultRNG {
+    igraph_integer_t integer(igraph_integer_t n) {
+        return igraph_rng_get_integer(igraph_rng_default(), 0, n - 1);
+    }
+    igraph_real_t unif01() {
+        return igraph_rng_get_unif01(igraph_rng_default());
+    }
+};
+
+inline void check_sampling_weights(const RealVec &weights) {
+    for (auto w : weights)
+        if (! (w >= 0 && w < IGRAPH_INFINITY))
+            throw Exception(IGRAPH_EINVAL);
+}
+
+} // namespace detail
+
+// Samples indices with probabilities proportional to a vector of weights.
+class AliasTable {
+    RealVec prob;
+    IntVec alias;
+
+public:
+    AliasTable() = default;
+
+    // Builds the table in O(n) time. Weights must be non-negative and finite, with a
+    // positive sum; indices of zero weight are never sampled.
+    explicit AliasTable(const RealVec &weights) : prob(weights.size()), alias(weights.size()) {
+        detail::check_sampling_weights(weights);
+        if (! (std::accumulate(weights.begin(), weights.end(), igraph_real_t(0)) > 0))
+            throw Exception(IGRAPH_EINVAL);
+        std::vector<igraph_integer_t> small, large;
+        detail::build_alias_table(weights.begin(), weights.size(), prob.begin(), alias.begin(), small, large);
+    }
+
+    igraph_integer_t size() const { return prob.size(); }
+
+    // Returns a random index in O(1) time. Throws IGRAPH_EINVAL if the table is empty.
+    template<typename RNG>
+    igraph_integer_t sample(RNG &rng) const {
+        if (prob.size() == 0)
+            throw Exception(IGRAPH_EINVAL);
+        const igraph_integer_t k = rng.integer(prob.size());
+        return rng.unif01() < prob[k] ? k : alias[k];
+    }
+
+    igraph_integer_t sample() const {
+        detail::DefaultRNG rng;
+        return sample(rng);
+    }
+};
+
+// Samples neighbours of vertices with probabilities proportional to the weights of the
+// connecting edges, using an alias table for each vertex.
+class NeighborAliasIndex {
+    igraph_integer_t n = 0;
+    IntVec offsets, targets, edges;  // sorted neighbour lists in compressed form
+    RealVec prob;                    // empty for uniform sampling
+    IntVec alias;
+
+    static constexpr igraph_integer_t grain = 256;
+
+public:
+    // Builds the index for a graph, which may be a Graph or any of its views. Weights
+    // must be non-negative and finite; edges of zero weight are left out. Without weights,
+    // neighbours are sampled uniformly, and no tables are needed. The mode determines
+    // whether out-neighbours (IGRAPH_OUT), in-neighbours (IGRAPH_IN) or both (IGRAPH_ALL)
+    // are sampled; it is ignored for undirected graphs.
+    template<typename G>
+    explicit NeighborAliasIndex(const G &graph, const RealVec *weights = nullptr, igraph_neimode_t mode = IGRAPH_OUT) {
+        auto &&g = view(graph);
+        detail::check_mode(mode);
+        if (weights) {
+            detail::check_edge_weights(g, *weights);
+            detail::check_sampling_weights(*weights);
+        }
+
+        n = g.vcount();
+        auto kept = [&](igraph_integer_t e) { return ! weights || (*weights)[e] > 0; };
+
+        offsets.resize(n + 1);
+        offsets[0] = 0;
+        detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            for (igraph_integer_t v = begin; v < end; ++v) {
+                igraph_integer_t deg = 0;
+                g.for_each_neighbor(v, mode, [&](igraph_integer_t, igraph_integer_t e) {
+                    deg += kept(e);
+                });
+                offsets[v + 1] = deg;
+            }
+        });
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        const igraph_integer_t m = offsets[n];
+        targets.resize(m);
+        edges.resize(m);
+        if (weights) {
+            prob.resize(m);
+            alias.resize(m);
+        }
+
+        struct Scratch {
+            std::vector<std::pair<igraph_integer_t, igraph_integer_t>> nei;
+            std::vector<igraph_real_t> w;
+            std::vector<igraph_integer_t> small, large;
+        };
+        std::vector<Scratch> scratch(thread_count());
+
+        detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned tid) {
+            Scratch &s = scratch[tid];
+            for (igraph_integer_t v = begin; v < end; ++v) {
+                s.nei.clear();
+                g.for_each_neighbor(v, mode, [&](igraph_integer_t u, igraph_integer_t e) {
+                    if (kept(e))
+                        s.nei.emplace_back(u, e);
+                });
+                std::sort(s.nei.begin(), s.nei.end());
+
+                const igraph_integer_t first = offsets[v], deg = s.nei.size();
+                for (igraph_integer_t i = 0; i < deg; ++i) {
+                    targets[first + i] = s.nei[i].first;
+                    edges[first + i] = s.nei[i].second;
+                }
+                if (weights && deg > 0) {
+                    s.w.resize(deg);
+                    for (igraph_integer_t i = 0; i < deg; ++i)
+                        s.w[i] = (*weights)[s.nei[i].second];
+                    detail::build_alias_table(s.w.data(), deg, &prob[first], &alias[first], s.small, s.large);
+                }
+            }
+        });
+    }
+
+    igraph_integer_t vcount() const { return n; }
+
+    // The number of neighbours of v that can be sampled, counted with multiplicity.
+    igraph_integer_t degree(igraph_integer_t v) const { return offsets[v + 1] - offsets[v]; }
+
+    // Returns a random neighbour of v in O(1) time, or -1 if there is none.
+    template<typename RNG>
+    igraph_integer_t sample_neighbor(igraph_integer_t v, RNG &rng) const {
+        const igraph_integer_t k = sample_slot(v, rng);
+        return k < 0 ? k : targets[k];
+    }
+
+    igraph_integer_t sample_neighbor(igraph_integer_t v) const {
+        detail::DefaultRNG rng;
+        return sample_neighbor(v, rng);
+    }
+
+    // Returns a random edge incident on v, with the same probabilities as
+    // sample_neighbor(), or -1 if there is none.
+    template<typename RNG>
+    igraph_integer_t sample_edge(igraph_integer_t v, RNG &rng) const {
+        const igraph_integer_t k = sample_slot(v, rng);
+        return k < 0 ? k : edges[k];
+    }
+
+    igraph_integer_t sample_edge(igraph_integer_t v) const {
+        detail::DefaultRNG rng;
+        return sample_edge(v, rng);
+    }
+
+    // Whether u is a neighbour of v that can be sampled, in O(log degree(v)) time.
+    bool is_neighbor(igraph_integer_t v, igraph_integer_t u) const {
+        return std::binary_search(targets.begin() + offsets[v], targets.begin() + offsets[v + 1], u);
+    }
+
+private:
+    template<typename RNG>
+    igraph_integer_t sample_slot(igraph_integer_t v, RNG &rng) const {
+        const igraph_integer_t first = offsets[v], deg = offsets[v + 1] - first;
+        if (deg == 0)
+            return -1;
+        const igraph_integer_t k = rng.integer(deg);
+        if (prob.empty() || rng.unif01() < prob[first + k])
+            return first + k;
+        return first + alias[first + k];
+    }
+};
@@ -0,0 +1,205 @@
+
+// Direction-optimizing breadth-first search.
+//
+// The search proceeds level by level, using multiple threads within each level.
+// While the frontier is small, it is expanded top-down: each frontier vertex claims
+// its unvisited neighbours. Once the edges leaving the frontier outnumber those that
+// remain to be explored, the search switches to bottom-up steps, where each unvisited
+// vertex looks for a parent in the frontier, and stops at the first one it finds.
+// In low-diameter graphs, this avoids examining most of the edges in the few levels
+// that contain the bulk of the vertices. The frontier is then held in a Bitset.
+
+namespace detail {
+
+// Switch to bottom-up when the frontier has more than 1/alpha of the unexplored
+// edges, and back to top-down when it has fewer than 1/beta of the vertices.
+constexpr igraph_integer_t bfs_alpha = 15;
+constexpr igraph_integer_t bfs_beta = 18;
+
+// Chunk size for the bottom-up steps; a multiple of the Bitset word size, so that
+// threads never write to the same word.
+constexpr igraph_integer_t bfs_grain = 1 << 12;
+
+} // namespace detail
+
+// The result of bfs().
+struct BFSResult {
+    IntVec parents; // the parent of each vertex in the search tree; -1 for sources, -2 if unreached
+    IntVec dist;    // the number of steps from the nearest source; -1 if unreached
+};
+
+// Breadth-first search from one or more sources, using multiple threads. Vertices
+// reachable from several sources are assigned to one of the nearest ones; when several
+// parents are possible, which one is chosen depends on thread scheduling. The mode
+// determines whether edges are followed in their own direction (IGRAPH_OUT), in reverse
+// (IGRAPH_IN) or both ways (IGRAPH_ALL); it is ignored for undirected graphs.
+template<typename G>
+BFSResult bfs(const G &graph, const IntVec &sources, igraph_neimode_t mode = IGRAPH_OUT) {
+    auto &&g = view(graph);
+    detail::check_mode(mode);
+    detail::check_vertices(g, sources);
+
+    using word = igraph_uint_t;
+    const igraph_integer_t word_bits = 8 * sizeof(word);
+    const igraph_integer_t grain = detail::bfs_grain;
+    const igraph_integer_t n = g.vcount();
+    const igraph_neimode_t pull_mode = detail::reverse_mode(mode);
+
+    BFSResult res;
+    res.dist.resize(n);
+    IntVec &dist = res.dist;
+
+    // -2 marks unvisited vertices. In top-down steps, vertices are claimed by
+    // exchanging this value for their parent.
+    std::vector<std::atomic<igraph_integer_t>> parents(n);
+    detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+        for (igraph_integer_t v = begin; v < end; ++v) {
+            parents[v].store(-2, std::memory_order_relaxed);
+            dist[v] = -1;
+        }
+    });
+
+    std::vector<igraph_integer_t> queue;
+    for (auto s : sources) {
+        if (dist[s] == 0)
+            continue;
+        parents[s].store(-1, std::memory_order_relaxed);
+        dist[s] = 0;
+        queue.push_back(s);
+    }
+
+    std::vector<std::vector<igraph_integer_t>> local(thread_count());
+
+    // Sets the bits of the vertices for which pred(v) is true, and returns their number.
+    // Each chunk covers whole words, which are written by a single thread.
+    auto fill_bits = [&](Bitset &bits, auto &&pred) {
+        word *words = bits.data();
+        return detail::parallel_sum<igraph_integer_t>(n, grain, [&](igraph_integer_t begin, igraph_integer_t end) {
+            igraph_integer_t count = 0;
+            for (igraph_integer_t w = begin; w < end; w += word_bits) {
+                word bitmask = 0;
+                for (igraph_integer_t v = w; v < std::min(w + word_bits, end); ++v) {
+                    if (pred(v)) {
+                        bitmask |= word(1) << (v - w);
+                        ++count;
+                    }
+                }
+                words[w / word_bits] = bitmask;
+            }
+            return count;
+        });
+    };
+
+    // Collects the vertices at distance 'level' into 'queue'.
+    auto collect_queue = [&](igraph_integer_t level) {
+        detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned tid) {
+            for (igraph_integer_t v = begin; v < end; ++v)
+                if (dist[v] == level)
+                    local[tid].push_back(v);
+        });
+        queue.clear();
+        for (auto &l : local) {
+            queue.insert(queue.end(), l.begin(), l.end());
+            l.clear();
+        }
+    };
+
+    // Counts the edges that bottom-up steps would examine from unvisited vertices.
+    auto count_unexplored = [&] {
+        return detail::parallel_sum<igraph_integer_t>(n, grain, [&](igraph_integer_t begin, igraph_integer_t end) {
+            igraph_integer_t sum = 0;
+            for (igraph_integer_t v = begin; v < end; ++v)
+                if (dist[v] < 0)
+                    sum += g.degree(v, pull_mode);
+            return sum;
+        });
+    };
+
+    Bitset bits_a(n), bits_b(n);
+    Bitset *frontier_bits = &bits_a, *next_bits = &bits_b;
+
+    bool bottom_up = false;
+    igraph_integer_t unexplored = count_unexplored();
+    igraph_integer_t frontier_size = queue.size();
+    igraph_integer_t prev_size = 0;
+
+    for (igraph_integer_t level = 0; frontier_size > 0; ++level) {
+        if (! bottom_up) {
+            const igraph_integer_t frontier_edges = detail::parallel_sum<igraph_integer_t>(
+                        frontier_size, grain, [&](igraph_integer_t begin, igraph_integer_t end) {
+                igraph_integer_t sum = 0;
+                for (igraph_integer_t i = begin; i < end; ++i)
+                    sum += g.degree(queue[i], mode);
+                return sum;
+            });
+            if (frontier_edges > unexplored / detail::bfs_alpha) {
+                bottom_up = true;
+                fill_bits(*frontier_bits, [&](igraph_integer_t v) { return dist[v] == level; });
+            }
+        } else if (frontier_size < n / detail::bfs_beta && frontier_size < prev_size) {
+            bottom_up = false;
+            collect_queue(level);
+            unexplored = count_unexplored();
+        }
+
+        prev_size = frontier_size;
+
+        if (bottom_up) {
+            // Only the frontier bits of other vertices are read, so each thread
+            // may update the entries of its own vertices without synchronization.
+            const Bitset &frontier = *frontier_bits;
+            frontier_size = fill_bits(*next_bits, [&](igraph_integer_t u) {
+                if (dist[u] >= 0)
+                    return false;
+                return ! g.for_each_neighbor(u, pull_mode, [&](igraph_integer_t v, igraph_integer_t) {
+                    if (! frontier[v])
+                        return true;
+                    parents[u].store(v, std::memory_order_relaxed);
+                    dist[u] = level + 1;
+                    return false;
+                });
+            });
+            std::swap(frontier_bits, next_bits);
+        } else {
+            std::atomic<igraph_integer_t> visited_edges{0};
+            detail::parallel_for(frontier_size, 256, [&](igraph_integer_t begin, igraph_integer_t end, unsigned tid) {
+                igraph_integer_t edges = 0;
+                for (igraph_integer_t i = begin; i < end; ++i) {
+                    const igraph_integer_t v = queue[i];
+                    g.for_each_neighbor(v, mode, [&](igraph_integer_t u, igraph_integer_t) {
+                        if (parents[u].load(std::memory_order_relaxed) != -2)
+                            return;
+                        igraph_integer_t expected = -2;
+                        if (parents[u].compare_exchange_strong(expected, v, std::memory_order_relaxed)) {
+                            dist[u] = level + 1;
+                            edges += g.degree(u, pull_mode);
+                            local[tid].push_back(u);
+                        }
+                    });
+                }
+                visited_edges.fetch_add(edges, std::memory_order_relaxed);
+            });
+            queue.clear();
+            for (auto &l : local) {
+                queue.insert(queue.end(), l.begin(), l.end());
+                l.clear();
+            }
+            frontier_size = queue.size();
+            unexplored -= visited_edges.load();
+        }
+    }
+
+    res.parents.resize(n);
+    detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+        for (igraph_integer_t v = begin; v < end; ++v)
+            res.parents[v] = parents[v].load(std::memory_order_relaxed);
+    });
+
+    return res;
+}
+
+// Breadth-first search from a single source, see above.
+template<typename G>
+BFSResult bfs(const G &graph, igraph_integer_t source, igraph_neimode_t mode = IGRAPH_OUT) {
+    return bfs(graph, IntVec{source}, mode);
+}
@@ -82,6 +82,10 @@ public:
 
     bool empty() const { return size() == 0; }
 
+    // The underlying storage words, each holding IGRAPH_INTEGER_SIZE bits.
+    igraph_uint_t *data() { return ptr->stor_begin; }
+    const igraph_uint_t *data() const { return ptr->stor_begin; }
+
     void resize(size_type size) { check(igraph_bitset_resize(ptr, size)); }
     void reserve(size_type capacity) { check(igraph_bitset_reserve(ptr, capacity)); }
 };
@@ -236,3 +240,35 @@ Bitset::reference Bitset::back() {
 Bitset::const_reference Bitset::back() const {
     return *(end() - 1);
 }
+
+namespace detail {
+
+// Bit manipulation helpers for 64-bit words. The argument must be non-zero.
+
+inline int count_trailing_zeros(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while (! (x & 1)) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+inline int count_leading_zeros(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#else
+    int n = 0;
+    while (! (x & (std::uint64_t(1) << 63))) {
+        x <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+} // namespace detail
@@ -0,0 +1,215 @@
+
+// Parallel computation of weakly connected components.
+//
+// connected_components() links the endpoints of all edges in a concurrent, lock-free
+// union-find structure. Following the Afforest approach, it first links only a couple
+// of neighbours per vertex, then identifies the largest intermediate component by
+// sampling, and skips the remaining edges of vertices that already belong to it.
+// This avoids touching most edges of the giant component that typical large
+// graphs have.
+
+namespace detail {
+
+// A union-find structure that supports concurrent unite() and find() calls.
+// Trees are always linked from the larger root index to the smaller one, so the
+// root of each set is its smallest element.
+class ConcurrentUnionFind {
+    std::vector<std::atomic<igraph_integer_t>> parent;
+
+public:
+    explicit ConcurrentUnionFind(igraph_integer_t n) : parent(n) {
+        parallel_for(n, 1 << 14, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            for (igraph_integer_t v = begin; v < end; ++v)
+                parent[v].store(v, std::memory_order_relaxed);
+        });
+    }
+
+    igraph_integer_t size() const { return parent.size(); }
+
+    // Finds the root of x, halving the path along the way.
+    igraph_integer_t find(igraph_integer_t x) {
+        for (;;) {
+            igraph_integer_t p = parent[x].load(std::memory_order_relaxed);
+            igraph_integer_t gp = parent[p].load(std::memory_order_relaxed);
+            if (p == gp)
+                return p;
+            parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+            x = gp;
+        }
+    }
+
+    void unite(igraph_integer_t a, igraph_integer_t b) {
+        for (;;) {
+            a = find(a);
+            b = find(b);
+            if (a == b)
+                return;
+            if (a < b)
+                std::swap(a, b);
+            igraph_integer_t expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed))
+                return;
+        }
+    }
+
+    // Points each element directly to its root. Must not run concurrently with unite().
+    void compress() {
+        parallel_for(size(), 1 << 14, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            for (igraph_integer_t v = begin; v < end; ++v)
+                parent[v].store(find(v), std::memory_order_relaxed);
+        });
+    }
+
+    // The parent of x; after compress(), its root.
+    igraph_integer_t parent_of(igraph_integer_t x) const {
+        return parent[x].load(std::memory_order_relaxed);
+    }
+};
+
+} // namespace detail
+
+// The result of connected_components().
+struct Components {
+    IntVec membership; // the component index of each vertex
+    IntVec sizes;      // the number of vertices in each component
+
+    igraph_integer_t count() const { return sizes.size(); }
+};
+
+// Computes the weakly connected components of a graph using multiple threads.
+// Edge directions are ignored. Components are numbered in the order of their
+// smallest vertex, as in igraph_connected_components().
+template<typename G>
+Components connected_components(const G &graph) {
+    auto &&g = view(graph);
+    const igraph_integer_t n = g.vcount();
+    const igraph_integer_t grain = 1 << 12;
+
+    detail::ConcurrentUnionFind uf(n);
+
+    // Link the first few neighbours of each vertex. This is usually enough to
+    // form most of the largest component.
+    const int sampled_rounds = 2;
+    detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+        for (igraph_integer_t v = begin; v < end; ++v) {
+            int k = 0;
+            g.for_each_neighbor(v, IGRAPH_ALL, [&](igraph_integer_t u, igraph_integer_t) {
+                uf.unite(v, u);
+                return ++k < sampled_rounds;
+            });
+        }
+    });
+    uf.compress();
+
+    // Find the most frequent root among a sample of vertices.
+    igraph_integer_t largest = -1;
+    if (n > 0) {
+        const igraph_integer_t samples = std::min<igraph_integer_t>(n, 1024);
+        std::vector<igraph_integer_t> roots(samples);
+        for (igraph_integer_t i = 0; i < samples; ++i)
+            roots[i] = uf.parent_of((i * igraph_integer_t(2654435761)) % n);
+        std::sort(roots.begin(), roots.end());
+        igraph_integer_t best = 0;
+        for (igraph_integer_t i = 0, j; i < samples; i = j) {
+            for (j = i; j < samples && roots[j] == roots[i]; ++j) ;
+            if (j - i > best) {
+                best = j - i;
+                largest = roots[i];
+            }
+        }
+    }
+
+    // Link all edges of the vertices outside of the largest component. Edges with
+    // both endpoints in it need not be considered, and edges with only one endpoint
+    // in it are seen from the other endpoint.
+    detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+        for (igraph_integer_t v = begin; v < end; ++v) {
+            if (uf.find(v) == largest)
+                continue;
+            g.for_each_neighbor(v, IGRAPH_ALL, [&](igraph_integer_t u, igraph_integer_t) {
+                uf.unite(v, u);
+            });
+        }
+    });
+    uf.compress();
+
+    // Each root is the smallest vertex of its component, so numbering roots in
+    // increasing order numbers the components by their smallest vertex.
+    Components res;
+    res.membership.resize(n);
+    const igraph_integer_t nchunks = (n + grain - 1) / grain;
+    std::vector<igraph_integer_t> offsets(nchunks + 1, 0);
+    detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+        igraph_integer_t count = 0;
+        for (igraph_integer_t v = begin; v < end; ++v)
+            if (uf.parent_of(v) == v)
+                ++count;
+        offsets[begin / grain + 1] = count;
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    // The label of each root is stored in its own membership entry before the
+    // labels of the remaining vertices are read from their roots.
+    detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+        igraph_integer_t label = offsets[begin / grain];
+        for (igraph_integer_t v = begin; v < end; ++v)
+            if (uf.parent_of(v) == v)
+                res.membership[v] = label++;
+    });
+    detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+        for (igraph_integer_t v = begin; v < end; ++v) {
+            igraph_integer_t root = uf.parent_of(v);
+            if (root != v)
+                res.membership[v] = res.membership[root];
+        }
+    });
+
+    res.sizes.resize(offsets.back());
+    std::fill(res.sizes.begin(), res.sizes.end(), 0);
+    for (auto c : res.membership)
+        res.sizes[c]++;
+
+    return res;
+}
+
+// Connected components whose subgraphs are only created when accessed.
+// The graph must outlive this object, and must not be modified while it is in use.
+class LazyComponents {
+    const igraph_t *graph;
+    Components comps;
+    IntVec offsets;  // component i consists of vids[offsets[i] .. offsets[i+1]-1]
+    IntVec vids;
+
+public:
+    explicit LazyComponents(const Graph &g) : graph(g), comps(connected_components(g)) {
+        const igraph_integer_t count = comps.count();
+        offsets.resize(count + 1);
+        offsets[0] = 0;
+        std::partial_sum(comps.sizes.begin(), comps.sizes.end(), offsets.begin() + 1);
+
+        IntVec pos = offsets;
+        vids.resize(comps.membership.size());
+        for (igraph_integer_t v = 0; v < comps.membership.size(); ++v)
+            vids[pos[comps.membership[v]]++] = v;
+    }
+
+    const Components &components() const { return comps; }
+
+    igraph_integer_t size() const { return comps.count(); }
+
+    // The vertices of component i, in increasing order.
+    IntVec vertices(igraph_integer_t i) const {
+        IntVec res(offsets[i + 1] - offsets[i]);
+        std::copy(vids.begin() + offsets[i], vids.begin() + offsets[i + 1], res.begin());
+        return res;
+    }
+
+    // Creates the subgraph induced by component i.
+    Graph operator [] (igraph_integer_t i) const {
+        igraph_vector_int_t slice;
+        igraph_vector_int_view(&slice, vids.begin() + offsets[i], offsets[i + 1] - offsets[i]);
+        igraph_t res;
+        check(igraph_induced_subgraph(graph, &res, igraph_vss_vector(&slice), IGRAPH_SUBGRAPH_AUTO));
+        return Graph(Capture(res));
+    }
+};
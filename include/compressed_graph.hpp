@@ -0,0 +1,272 @@
+
+// Compressed read-only graphs.
+//
+// CompressedGraph stores the sorted neighbour list of each vertex as gaps between
+// consecutive neighbours, encoded with StreamVByte (Lemire et al.): each group of four
+// 32-bit values is described by one control byte holding their byte lengths (1 to 4),
+// and the control bytes of a list are stored before its data bytes. The first value of
+// each list is the zigzag-encoded difference between the first neighbour and the vertex
+// itself, so that graphs with good locality (see reorder()) compress well. Each list
+// starts with its length as a LEB128 varint, and is found through an offset per vertex.
+//
+// With SSSE3, each group of four values is decoded with a single byte shuffle.
+// Otherwise, values are decoded one at a time.
+//
+// CompressedGraph implements the interface of GraphView, decoding neighbours on the
+// fly, so traversals such as bfs() can run on it directly. Edge IDs are not stored:
+// for_each_neighbor() reports -1 for them, so algorithms given edge weights reject it
+// with IGRAPH_EINVAL.
+
+namespace detail {
+
+inline void append_varint(std::vector<std::uint8_t> &out, std::uint64_t x) {
+    while (x >= 0x80) {
+        out.push_back(std::uint8_t(x | 0x80));
+        x >>= 7;
+    }
+    out.push_back(std::uint8_t(x));
+}
+
+inline std::uint64_t read_varint(const std::uint8_t *&p) {
+    std::uint64_t x = 0;
+    for (int shift = 0; ; shift += 7) {
+        const std::uint8_t b = *p++;
+        x |= std::uint64_t(b & 0x7f) << shift;
+        if (b < 0x80)
+            return x;
+    }
+}
+
+// Appends the StreamVByte encoding of 'values' to 'out'.
+inline void stream_vbyte_encode(const std::vector<std::uint32_t> &values, std::vector<std::uint8_t> &out) {
+    const std::size_t count = values.size();
+    const std::size_t control = out.size();
+    out.resize(control + (count + 3) / 4, 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint32_t x = values[i];
+        const int len = x < (1u << 8) ? 1 : x < (1u << 16) ? 2 : x < (1u << 24) ? 3 : 4;
+        out[control + i / 4] |= std::uint8_t((len - 1) << (2 * (i % 4)));
+        for (int b = 0; b < len; ++b)
+            out.push_back(std::uint8_t(x >> (8 * b)));
+    }
+}
+
+// Decodes the four values described by control byte 'c' from 'data', and returns the
+// number of data bytes used. May read up to 16 bytes from 'data'.
+inline std::size_t stream_vbyte_decode_quad(std::uint8_t c, const std::uint8_t *data, std::uint32_t *out) {
+#if defined(__SSSE3__)
+    struct Tables {
+        std::uint8_t shuffle[256][16];
+        std::uint8_t length[256];
+
+        Tables() {
+            for (int c = 0; c < 256; ++c) {
+                int pos = 0;
+                for (int i = 0; i < 4; ++i) {
+                    const int len = ((c >> (2 * i)) & 3) + 1;
+                    for (int b = 0; b < 4; ++b)
+                        shuffle[c][4 * i + b] = b < len ? pos + b : 0x80;
+                    pos += len;
+                }
+                length[c] = pos;
+            }
+        }
+    };
+    static const Tables tables;
+
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(tables.shuffle[c]));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_shuffle_epi8(in, mask));
+    return tables.length[c];
+#else
+    std::size_t pos = 0;
+    for (int i = 0; i < 4; ++i) {
+        const int len = ((c >> (2 * i)) & 3) + 1;
+        std::uint32_t x = 0;
+        for (int b = 0; b < len; ++b)
+            x |= std::uint32_t(data[pos + b]) << (8 * b);
+        out[i] = x;
+        pos += len;
+    }
+    return pos;
+#endif
+}
+
+} // namespace detail
+
+class CompressedGraph {
+    igraph_integer_t n = 0, m = 0;
+    bool directed = false;
+
+    // Out-neighbours, or all neighbours in undirected graphs, and in-neighbours of
+    // directed graphs. Each buffer is followed by 16 bytes of padding for SIMD loads.
+    std::vector<std::uint64_t> out_offsets, in_offsets;
+    std::vector<std::uint8_t> out_data, in_data;
+
+    static constexpr igraph_integer_t grain = 1 << 10;
+
+    template<typename G>
+    static void build(const G &g, igraph_neimode_t mode, std::vector<std::uint64_t> &offsets,
+                      std::vector<std::uint8_t> &data) {
+        const igraph_integer_t n = g.vcount();
+        const igraph_integer_t nchunks = (n + grain - 1) / grain;
+
+        // Each chunk of vertices is encoded separately, then the chunks are concatenated.
+        std::vector<std::vector<std::uint8_t>> chunks(nchunks);
+        offsets.resize(n + 1);
+        detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            std::vector<std::uint8_t> &out = chunks[begin / grain];
+            std::vector<igraph_integer_t> neis;
+            std::vector<std::uint32_t> values;
+            for (igraph_integer_t v = begin; v < end; ++v) {
+                neis.clear();
+                g.for_each_neighbor(v, mode, [&](igraph_integer_t u, igraph_integer_t) {
+                    neis.push_back(u);
+                });
+                std::sort(neis.begin(), neis.end());
+
+                values.resize(neis.size());
+                for (std::size_t i = 0; i < neis.size(); ++i) {
+                    if (i == 0) {
+                        const std::int64_t diff = neis[0] - v;
+                        values[i] = std::uint32_t((std::uint64_t(diff) << 1) ^ std::uint64_t(diff >> 63));
+                    } else {
+                        values[i] = std::uint32_t(neis[i] - neis[i - 1]);
+                    }
+                }
+
+                offsets[v] = out.size();
+                detail::append_varint(out, values.size());
+                detail::stream_vbyte_encode(values, out);
+            }
+        });
+
+        std::vector<std::uint64_t> chunk_start(nchunks + 1, 0);
+        for (igraph_integer_t c = 0; c < nchunks; ++c)
+            chunk_start[c + 1] = chunk_start[c] + chunks[c].size();
+        data.resize(chunk_start[nchunks] + 16);
+        detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            const igraph_integer_t c = begin / grain;
+            std::copy(chunks[c].begin(), chunks[c].end(), data.begin() + chunk_start[c]);
+            for (igraph_integer_t v = begin; v < end; ++v)
+                offsets[v] += chunk_start[c];
+            std::vector<std::uint8_t>().swap(chunks[c]);
+        });
+        offsets[n] = chunk_start[nchunks];
+    }
+
+    static igraph_integer_t list_size(const std::vector<std::uint8_t> &data, std::uint64_t offset) {
+        const std::uint8_t *p = &data[offset];
+        return detail::read_varint(p);
+    }
+
+    template<typename F>
+    static bool decode(const std::vector<std::uint8_t> &data, std::uint64_t offset, igraph_integer_t v, F &&f) {
+        const std::uint8_t *p = &data[offset];
+        const igraph_integer_t count = detail::read_varint(p);
+        if (count == 0)
+            return true;
+
+        const std::uint8_t *control = p;
+        const std::uint8_t *bytes = p + (count + 3) / 4;
+        std::uint32_t buf[4];
+
+        // The first value is the zigzag-encoded difference from v.
+        bytes += detail::stream_vbyte_decode_quad(control[0], bytes, buf);
+        igraph_integer_t u = v + (igraph_integer_t(buf[0] >> 1) ^ -igraph_integer_t(buf[0] & 1));
+        if (! detail::invoke_continue(f, u, igraph_integer_t(-1)))
+            return false;
+        for (igraph_integer_t i = 1; i < count; ++i) {
+            if (i % 4 == 0)
+                bytes += detail::stream_vbyte_decode_quad(control[i / 4], bytes, buf);
+            u += buf[i % 4];
+            if (! detail::invoke_continue(f, u, igraph_integer_t(-1)))
+                return false;
+        }
+        return true;
+    }
+
+public:
+    // Compresses the structure of a graph, which may be a Graph or any of its views.
+    // Throws IGRAPH_EOVERFLOW for graphs with 2^31 or more vertices.
+    template<typename G, typename = decltype(view(std::declval<const G &>()))>
+    explicit CompressedGraph(const G &graph) {
+        auto &&g = view(graph);
+        n = g.vcount();
+        m = g.ecount();
+        directed = g.is_directed();
+        if (n >= (igraph_integer_t(1) << 31))
+            throw Exception(IGRAPH_EOVERFLOW);
+
+        if (directed) {
+            build(g, IGRAPH_OUT, out_offsets, out_data);
+            build(g, IGRAPH_IN, in_offsets, in_data);
+        } else {
+            build(g, IGRAPH_ALL, out_offsets, out_data);
+        }
+    }
+
+    // Decompresses the graph. Vertex IDs are preserved, but edge IDs are not.
+    Graph to_graph() const {
+        IntVec edges;
+        edges.reserve(2 * m);
+        for (igraph_integer_t v = 0; v < n; ++v) {
+            // In undirected graphs, each edge is listed at both endpoints, and self-loops
+            // twice at the same vertex.
+            bool skip_loop = false;
+            decode(out_data, out_offsets[v], v, [&](igraph_integer_t u, igraph_integer_t) {
+                if (! directed) {
+                    if (u < v)
+                        return;
+                    if (u == v) {
+                        skip_loop = ! skip_loop;
+                        if (skip_loop)
+                            return;
+                    }
+                }
+                edges.push_back(v);
+                edges.push_back(u);
+            });
+        }
+        return Graph(edges, n, directed);
+    }
+
+    // The memory used by the graph, in bytes.
+    std::size_t memory_size() const {
+        return sizeof(std::uint64_t) * (out_offsets.size() + in_offsets.size()) + out_data.size() + in_data.size();
+    }
+
+    igraph_integer_t vcount() const { return n; }
+    igraph_integer_t ecount() const { return m; }
+    bool is_directed() const { return directed; }
+
+    igraph_integer_t degree(igraph_integer_t v, igraph_neimode_t mode = IGRAPH_OUT) const {
+        if (! directed)
+            return list_size(out_data, out_offsets[v]);
+        igraph_integer_t deg = 0;
+        if (mode & IGRAPH_OUT)
+            deg += list_size(out_data, out_offsets[v]);
+        if (mode & IGRAPH_IN)
+            deg += list_size(in_data, in_offsets[v]);
+        return deg;
+    }
+
+    // See GraphView::for_each_neighbor(). Neighbours are visited in increasing order
+    // (out-neighbours first with IGRAPH_ALL), and edge IDs are reported as -1.
+    template<typename F>
+    bool for_each_neighbor(igraph_integer_t v, igraph_neimode_t mode, F &&f) const {
+        if (! directed)
+            mode = IGRAPH_OUT;
+        if ((mode & IGRAPH_OUT) && ! decode(out_data, out_offsets[v], v, f))
+            return false;
+        if ((mode & IGRAPH_IN) && ! decode(in_data, in_offsets[v], v, f))
+            return false;
+        return true;
+    }
+};
+
+namespace detail {
+template<> struct reports_edge_ids<CompressedGraph> : std::false_type { };
+} // namespace detail
+
+inline const CompressedGraph &view(const CompressedGraph &graph) { return graph; }
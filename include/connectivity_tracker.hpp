@@ -0,0 +1,169 @@
+
+// Incremental connectivity under edge insertions.
+//
+// ConnectivityTracker maintains the weakly connected components of a graph in a
+// union-find structure, with union by size and path halving. Adding an edge takes
+// nearly constant time, and so do queries: connected(u, v), the number of components,
+// and the size of the component of a vertex. Queries do not modify the structure, so
+// they can run concurrently. Deleting edges may split components, which union-find
+// cannot do: after deletions, the tracker must be rebuilt from the graph, which
+// rebuild() does with connected_components().
+//
+// A tracker created from a Graph is attached to it: update() detects that the graph
+// was modified, using Graph::version(), and rebuilds the tracker. Edges added to the
+// graph can instead be recorded with add_edges(), which keeps the tracker valid without
+// a rebuild, but is not detected. A DynamicGraph can maintain a tracker itself, updated
+// incrementally as edges are added, see DynamicGraph::track_connectivity().
+
+class ConnectivityTracker {
+    std::vector<igraph_integer_t> parent, size;
+    igraph_integer_t ncomps = 0;
+
+    // The Graph the tracker is attached to, and its version when last rebuilt.
+    const Graph *graph = nullptr;
+    std::uint64_t version = 0;
+
+    // Finds the root of v, halving the path along the way.
+    igraph_integer_t find(igraph_integer_t v) {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    }
+
+    igraph_integer_t root(igraph_integer_t v) const {
+        while (parent[v] != v)
+            v = parent[v];
+        return v;
+    }
+
+    void check_vertex(igraph_integer_t v) const {
+        if (v < 0 || v >= vcount())
+            throw Exception(IGRAPH_EINVVID);
+    }
+
+public:
+    // Tracks a graph with n vertices and no edges.
+    explicit ConnectivityTracker(igraph_integer_t n = 0) {
+        add_vertices(n);
+    }
+
+    // Tracks the components of a Graph, and attaches to it; see update(). The graph must
+    // outlive the tracker.
+    explicit ConnectivityTracker(const Graph &graph_) : graph(&graph_), version(graph_.version()) {
+        rebuild(graph_);
+    }
+
+    // Tracks the components of a graph view, without attaching to it.
+    template<typename G, typename = decltype(view(std::declval<const G &>()))>
+    explicit ConnectivityTracker(const G &graph) {
+        rebuild(graph);
+    }
+
+    // If the tracker is attached to a Graph that was modified since the tracker was built
+    // or last updated, rebuilds it from the graph, and returns true. Edges recorded with
+    // add_edges() in the meantime are discarded.
+    bool update() {
+        if (! graph || graph->version() == version)
+            return false;
+        version = graph->version();
+        rebuild(*graph);
+        return true;
+    }
+
+    // Recomputes the components from a graph, which may be a Graph or any of its views,
+    // using multiple threads.
+    template<typename G>
+    void rebuild(const G &graph) {
+        Components comps = connected_components(graph);
+        const igraph_integer_t n = comps.membership.size();
+
+        // The first vertex of each component becomes its root.
+        std::vector<igraph_integer_t> first(comps.count(), -1);
+        parent.resize(n);
+        size.assign(n, 1);
+        for (igraph_integer_t v = 0; v < n; ++v) {
+            const igraph_integer_t c = comps.membership[v];
+            if (first[c] < 0) {
+                first[c] = v;
+                size[v] = comps.sizes[c];
+            }
+            parent[v] = first[c];
+        }
+        ncomps = comps.count();
+    }
+
+    igraph_integer_t vcount() const { return parent.size(); }
+
+    // Adds 'count' isolated vertices.
+    void add_vertices(igraph_integer_t count) {
+        if (count < 0)
+            throw Exception(IGRAPH_EINVAL);
+        const igraph_integer_t n = vcount();
+        parent.resize(n + count);
+        size.resize(n + count, 1);
+        std::iota(parent.begin() + n, parent.end(), n);
+        ncomps += count;
+    }
+
+    // Records an edge between u and v. Returns whether it joined two components.
+    bool add_edge(igraph_integer_t u, igraph_integer_t v) {
+        check_vertex(u);
+        check_vertex(v);
+        u = find(u);
+        v = find(v);
+        if (u == v)
+            return false;
+        if (size[u] < size[v])
+            std::swap(u, v);
+        parent[v] = u;
+        size[u] += size[v];
+        --ncomps;
+        return true;
+    }
+
+    // Records edges given as consecutive pairs of vertex IDs.
+    void add_edges(const IntVec &edges) {
+        if (edges.size() % 2 != 0)
+            throw Exception(IGRAPH_EINVAL);
+        for (igraph_integer_t i = 0; i < edges.size(); i += 2)
+            add_edge(edges[i], edges[i + 1]);
+    }
+
+    bool connected(igraph_integer_t u, igraph_integer_t v) const {
+        check_vertex(u);
+        check_vertex(v);
+        return root(u) == root(v);
+    }
+
+    // The number of components.
+    igraph_integer_t count() const { return ncomps; }
+
+    // Whether the graph is connected. As in igraph, the null graph is not.
+    bool is_connected() const { return ncomps == 1; }
+
+    // The number of vertices in the component of v.
+    igraph_integer_t component_size(igraph_integer_t v) const {
+        check_vertex(v);
+        return size[root(v)];
+    }
+
+    // The components, numbered in the order of their smallest vertex, as in
+    // connected_components().
+    Components components() const {
+        const igraph_integer_t n = vcount();
+        std::vector<igraph_integer_t> label(n, -1);
+        Components res;
+        res.membership.resize(n);
+        for (igraph_integer_t v = 0; v < n; ++v) {
+            const igraph_integer_t r = root(v);
+            if (label[r] < 0) {
+                label[r] = res.sizes.size();
+                res.sizes.push_back(size[r]);
+            }
+            res.membership[v] = label[r];
+        }
+        return res;
+    }
+};
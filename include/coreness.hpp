@@ -0,0 +1,107 @@
+
+// Parallel k-core decomposition.
+//
+// Vertices are peeled level by level. At level k, all remaining vertices of degree at
+// most k are removed in parallel, and their neighbours' degrees are decremented with
+// atomic operations. A neighbour whose degree drops to exactly k joins the next round
+// of the same level; since degrees only decrease, each vertex joins exactly once. When
+// no vertices are left at level k, the next level is the smallest remaining degree,
+// so that empty levels are skipped. The list of remaining vertices is compacted as it
+// is scanned, so later levels only visit the vertices of the denser cores.
+
+// Computes the coreness of each vertex using multiple threads: the largest k for which
+// the vertex belongs to the k-core, the maximal subgraph in which all vertices have
+// degree at least k. The mode determines whether out-degrees (IGRAPH_OUT), in-degrees
+// (IGRAPH_IN) or total degrees (IGRAPH_ALL) are considered; it is ignored for undirected
+// graphs. If 'max_k' is non-negative, peeling stops at that level, and vertices with
+// coreness 'max_k' or larger are assigned 'max_k'.
+template<typename G>
+IntVec coreness(const G &graph, igraph_neimode_t mode = IGRAPH_ALL, igraph_integer_t max_k = -1) {
+    auto &&g = view(graph);
+    detail::check_mode(mode);
+
+    const igraph_integer_t n = g.vcount();
+    const igraph_integer_t grain = 1 << 12;
+    const igraph_neimode_t peel_mode = detail::reverse_mode(mode);
+
+    IntVec core(n);
+    std::vector<std::atomic<igraph_integer_t>> degree(n);
+    std::vector<igraph_integer_t> remaining(n);
+    detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+        for (igraph_integer_t v = begin; v < end; ++v) {
+            degree[v].store(g.degree(v, mode), std::memory_order_relaxed);
+            core[v] = -1;
+            remaining[v] = v;
+        }
+    });
+
+    const unsigned nthreads = thread_count();
+    std::vector<std::vector<igraph_integer_t>> local(nthreads), kept(nthreads);
+    std::vector<igraph_integer_t> frontier;
+
+    auto gather = [](std::vector<std::vector<igraph_integer_t>> &parts, std::vector<igraph_integer_t> &out) {
+        out.clear();
+        for (auto &p : parts) {
+            out.insert(out.end(), p.begin(), p.end());
+            p.clear();
+        }
+    };
+
+    // Each level is the smallest degree among the remaining vertices.
+    igraph_integer_t k = IGRAPH_INTEGER_MAX;
+    for (auto &d : degree)
+        k = std::min(k, d.load(std::memory_order_relaxed));
+
+    while (! remaining.empty()) {
+        if (max_k >= 0 && k >= max_k) {
+            for (auto v : remaining)
+                core[v] = max_k;
+            break;
+        }
+
+        // Split the remaining vertices into those peeled at this level and the rest.
+        std::vector<igraph_integer_t> next_min(nthreads, IGRAPH_INTEGER_MAX);
+        detail::parallel_for(remaining.size(), grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned tid) {
+            for (igraph_integer_t i = begin; i < end; ++i) {
+                const igraph_integer_t v = remaining[i];
+                if (degree[v].load(std::memory_order_relaxed) <= k)
+                    local[tid].push_back(v);
+                else
+                    kept[tid].push_back(v);
+            }
+        });
+        gather(local, frontier);
+        gather(kept, remaining);
+
+        while (! frontier.empty()) {
+            detail::parallel_for(frontier.size(), 256, [&](igraph_integer_t begin, igraph_integer_t end, unsigned tid) {
+                for (igraph_integer_t i = begin; i < end; ++i) {
+                    const igraph_integer_t v = frontier[i];
+                    core[v] = k;
+                    g.for_each_neighbor(v, peel_mode, [&](igraph_integer_t u, igraph_integer_t) {
+                        if (degree[u].load(std::memory_order_relaxed) <= k)
+                            return;
+                        if (degree[u].fetch_sub(1, std::memory_order_relaxed) == k + 1)
+                            local[tid].push_back(u);
+                    });
+                }
+            });
+            gather(local, frontier);
+        }
+
+        // Vertices peeled in later rounds of this level are still in the list.
+        detail::parallel_for(remaining.size(), grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned tid) {
+            for (igraph_integer_t i = begin; i < end; ++i) {
+                const igraph_integer_t v = remaining[i];
+                if (core[v] < 0) {
+                    kept[tid].push_back(v);
+                    next_min[tid] = std::min(next_min[tid], degree[v].load(std::memory_order_relaxed));
+                }
+            }
+        });
+        gather(kept, remaining);
+        k = *std::min_element(next_min.begin(), next_min.end());
+    }
+
+    return core;
+}
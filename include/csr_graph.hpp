@@ -0,0 +1,140 @@
+
+// Compact read-only graphs in compressed sparse row form.
+//
+// igraph stores all indices as 64-bit igraph_integer_t, and reaches the neighbours of
+// a vertex through an extra level of indirection (edge index, then endpoint). CSRGraph
+// stores, for each vertex, its neighbours and the connecting edge IDs contiguously,
+// using a configurable index type. With 32-bit indices, a neighbour scan reads 8 bytes
+// per incident edge instead of 16, and the whole graph takes half the memory of a
+// Graph. To achieve this, edge endpoints are not stored separately, so CSRGraph does
+// not provide from() and to().
+//
+// CSRGraph implements the rest of the interface of GraphView, so it can be passed to
+// the parallel algorithms of igraph-cpp in place of a Graph, with identical results:
+// neighbours are visited in the same order, and edge IDs are preserved.
+
+template<typename Index>
+class CSRGraph {
+    static_assert(std::is_integral<Index>::value, "CSRGraph requires an integer index type.");
+
+    igraph_integer_t n = 0, m = 0;
+    bool directed = false;
+
+    // Out-neighbours, or all neighbours in undirected graphs.
+    std::vector<Index> out_offsets, out_neighbors, out_edges;
+    // In-neighbours of directed graphs.
+    std::vector<Index> in_offsets, in_neighbors, in_edges;
+
+    static constexpr igraph_integer_t grain = 1 << 10;
+
+    template<typename G>
+    static void build(const G &g, igraph_neimode_t mode, std::vector<Index> &offsets,
+                      std::vector<Index> &neighbors, std::vector<Index> &edges) {
+        const igraph_integer_t n = g.vcount();
+        std::vector<igraph_integer_t> start(n + 1);
+        start[0] = 0;
+        detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            for (igraph_integer_t v = begin; v < end; ++v)
+                start[v + 1] = g.degree(v, mode);
+        });
+        std::partial_sum(start.begin(), start.end(), start.begin());
+
+        offsets.assign(start.begin(), start.end());
+        neighbors.resize(start[n]);
+        edges.resize(start[n]);
+        detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            for (igraph_integer_t v = begin; v < end; ++v) {
+                igraph_integer_t k = start[v];
+                g.for_each_neighbor(v, mode, [&](igraph_integer_t u, igraph_integer_t e) {
+                    neighbors[k] = u;
+                    edges[k] = e;
+                    ++k;
+                });
+            }
+        });
+    }
+
+public:
+    using index_type = Index;
+
+    // Copies the structure of a graph, which may be a Graph or any of its views.
+    // Throws IGRAPH_EOVERFLOW if the number of vertices, or the total length of the
+    // neighbour lists, does not fit in the index type.
+    template<typename G, typename = decltype(view(std::declval<const G &>()))>
+    explicit CSRGraph(const G &graph) {
+        auto &&g = view(graph);
+        n = g.vcount();
+        m = g.ecount();
+        directed = g.is_directed();
+
+        // Neighbour lists hold each edge once per direction in directed graphs, and twice
+        // in undirected graphs.
+        const std::uint64_t max_index = std::numeric_limits<Index>::max();
+        if (std::uint64_t(n) > max_index || std::uint64_t(directed ? m : 2 * m) > max_index)
+            throw Exception(IGRAPH_EOVERFLOW);
+
+        if (directed) {
+            build(g, IGRAPH_OUT, out_offsets, out_neighbors, out_edges);
+            build(g, IGRAPH_IN, in_offsets, in_neighbors, in_edges);
+        } else {
+            build(g, IGRAPH_ALL, out_offsets, out_neighbors, out_edges);
+        }
+    }
+
+    // Converts back to a Graph, with the same vertex and edge IDs. The endpoints of each
+    // edge are recovered from the out-neighbour lists; an undirected edge is seen from
+    // both of its endpoints, and stored with from >= to, as igraph does.
+    Graph to_graph() const {
+        IntVec edges(2 * m);
+        for (igraph_integer_t v = 0; v < n; ++v) {
+            for (igraph_integer_t k = out_offsets[v]; k < igraph_integer_t(out_offsets[v + 1]); ++k) {
+                const igraph_integer_t u = out_neighbors[k], e = out_edges[k];
+                edges[2 * e] = directed ? v : std::max(u, v);
+                edges[2 * e + 1] = directed ? u : std::min(u, v);
+            }
+        }
+        return Graph(edges, n, directed);
+    }
+
+    // The memory used by the graph, in bytes.
+    std::size_t memory_size() const {
+        return sizeof(Index) * (out_offsets.size() + out_neighbors.size() + out_edges.size() +
+                                in_offsets.size() + in_neighbors.size() + in_edges.size());
+    }
+
+    igraph_integer_t vcount() const { return n; }
+    igraph_integer_t ecount() const { return m; }
+    bool is_directed() const { return directed; }
+
+    igraph_integer_t degree(igraph_integer_t v, igraph_neimode_t mode = IGRAPH_OUT) const {
+        if (! directed)
+            return out_offsets[v + 1] - out_offsets[v];
+        igraph_integer_t deg = 0;
+        if (mode & IGRAPH_OUT)
+            deg += out_offsets[v + 1] - out_offsets[v];
+        if (mode & IGRAPH_IN)
+            deg += in_offsets[v + 1] - in_offsets[v];
+        return deg;
+    }
+
+    // See GraphView::for_each_neighbor().
+    template<typename F>
+    bool for_each_neighbor(igraph_integer_t v, igraph_neimode_t mode, F &&f) const {
+        if (! directed)
+            mode = IGRAPH_OUT;
+        if (mode & IGRAPH_OUT) {
+            for (igraph_integer_t k = out_offsets[v]; k < igraph_integer_t(out_offsets[v + 1]); ++k)
+                if (! detail::invoke_continue(f, igraph_integer_t(out_neighbors[k]), igraph_integer_t(out_edges[k])))
+                    return false;
+        }
+        if (mode & IGRAPH_IN) {
+            for (igraph_integer_t k = in_offsets[v]; k < igraph_integer_t(in_offsets[v + 1]); ++k)
+                if (! detail::invoke_continue(f, igraph_integer_t(in_neighbors[k]), igraph_integer_t(in_edges[k])))
+                    return false;
+        }
+        return true;
+    }
+};
+
+template<typename Index>
+const CSRGraph<Index> &view(const CSRGraph<Index> &graph) { return graph; }
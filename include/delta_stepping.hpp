@@ -0,0 +1,184 @@
+
+// Parallel single-source shortest paths on weighted graphs (delta-stepping).
+//
+// Tentative distances are sorted into buckets of width delta. All vertices in the
+// lowest non-empty bucket are relaxed in parallel, and the bucket is revisited until
+// no more vertices fall into it; then the next one is processed. Small values of delta
+// approach Dijkstra's algorithm, large ones approach Bellman-Ford. Relaxations lower
+// distances with atomic operations, and each thread keeps its own buckets.
+//
+// Since relaxing edges from bucket i only produces distances below (i+1)*delta plus the
+// largest weight, only a fixed number of buckets are in use at any time, and these are
+// stored in a circular array.
+
+namespace detail {
+
+// Lowers 'target' to 'value' if it is smaller. Returns true if it was lowered.
+inline bool atomic_fetch_min(std::atomic<igraph_real_t> &target, igraph_real_t value) {
+    igraph_real_t current = target.load(std::memory_order_relaxed);
+    while (value < current)
+        if (target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            return true;
+    return false;
+}
+
+// Sets pred[v] to a vertex u preceding v on a shortest path, i.e. one with
+// dist[u] + w == dist[v] for an edge u -> v of weight w.
+template<typename G>
+void shortest_path_predecessors(const G &g, igraph_integer_t source, const RealVec &weights,
+                                const RealVec &dist, IntVec &pred, igraph_neimode_t mode) {
+    const igraph_integer_t n = g.vcount();
+    const igraph_neimode_t pull_mode = reverse_mode(mode);
+    pred.resize(n);
+
+    // With positive weights, predecessors are strictly closer to the source, so any
+    // choice gives a tree. Vertices whose only predecessors are at the same distance
+    // (zero weights) are flagged.
+    std::atomic<bool> ties{false};
+    parallel_for(n, 1 << 12, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+        for (igraph_integer_t v = begin; v < end; ++v) {
+            if (v == source) {
+                pred[v] = -1;
+                continue;
+            }
+            pred[v] = -2;
+            if (dist[v] == IGRAPH_INFINITY)
+                continue;
+            g.for_each_neighbor(v, pull_mode, [&](igraph_integer_t u, igraph_integer_t e) {
+                if (dist[u] + weights[e] != dist[v] || dist[u] == dist[v])
+                    return true;
+                pred[v] = u;
+                return false;
+            });
+            if (pred[v] == -2)
+                ties.store(true, std::memory_order_relaxed);
+        }
+    });
+    if (! ties.load())
+        return;
+
+    // Otherwise, build the tree by a search along the edges of shortest paths.
+    std::fill(pred.begin(), pred.end(), -2);
+    pred[source] = -1;
+    std::vector<igraph_integer_t> queue = {source};
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+        const igraph_integer_t u = queue[i];
+        g.for_each_neighbor(u, mode, [&](igraph_integer_t v, igraph_integer_t e) {
+            if (pred[v] == -2 && dist[u] + weights[e] == dist[v]) {
+                pred[v] = u;
+                queue.push_back(v);
+            }
+        });
+    }
+}
+
+} // namespace detail
+
+// Computes weighted shortest path lengths from 'source' to all vertices using multiple
+// threads, and stores them in 'dist'. Unreachable vertices get IGRAPH_INFINITY.
+// Weights must be non-negative; edges with infinite weight are ignored.
+//
+// If 'pred' is given, the predecessor of each vertex on a shortest path from the source
+// is stored in it, with -1 for the source and -2 for unreachable vertices.
+//
+// 'delta' is the bucket width. It only affects performance; when zero, the largest weight
+// divided by the average degree is used, which works well for most weight distributions.
+template<typename G>
+void distances_delta_stepping(const G &graph, RealVec &dist, igraph_integer_t source,
+                              const RealVec &weights, IntVec *pred = nullptr,
+                              igraph_neimode_t mode = IGRAPH_OUT, igraph_real_t delta = 0) {
+    auto &&g = view(graph);
+    const igraph_integer_t n = g.vcount();
+    const igraph_integer_t m = g.ecount();
+
+    detail::check_mode(mode);
+    if (source < 0 || source >= n)
+        throw Exception(IGRAPH_EINVVID);
+    detail::check_edge_weights(g, weights);
+    if (! (delta >= 0))
+        throw Exception(IGRAPH_EINVAL);
+
+    igraph_real_t max_weight = 0;
+    for (auto w : weights) {
+        if (! (w >= 0))
+            throw Exception(IGRAPH_EINVAL);
+        if (w != IGRAPH_INFINITY && w > max_weight)
+            max_weight = w;
+    }
+
+    // Limit the number of buckets that can be in use at the same time.
+    const igraph_integer_t max_buckets = 1 << 16;
+    if (delta == 0)
+        delta = max_weight * n / std::max<igraph_integer_t>(m, 1);
+    delta = std::max(delta, max_weight / (max_buckets - 2));
+    if (delta == 0)
+        delta = 1;
+    const igraph_integer_t nbuckets = igraph_integer_t(max_weight / delta) + 2;
+
+    std::vector<std::atomic<igraph_real_t>> d(n);
+    detail::parallel_for(n, 1 << 12, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+        for (igraph_integer_t v = begin; v < end; ++v)
+            d[v].store(IGRAPH_INFINITY, std::memory_order_relaxed);
+    });
+
+    // buckets[tid][i % nbuckets] holds the vertices added by thread tid to bucket i.
+    // A vertex may appear in several buckets; only the entry matching its current
+    // distance is processed.
+    using bucket_type = std::vector<igraph_integer_t>;
+    std::vector<std::vector<bucket_type>> buckets(thread_count(), std::vector<bucket_type>(nbuckets));
+    std::vector<igraph_integer_t> frontier, offsets(buckets.size() + 1);
+
+    auto bucket_of = [&](igraph_real_t x) { return igraph_integer_t(x / delta); };
+
+    d[source].store(0, std::memory_order_relaxed);
+    buckets[0][0].push_back(source);
+
+    for (igraph_integer_t current = 0; ; ) {
+        // Find the lowest non-empty bucket.
+        igraph_integer_t next = -1;
+        for (igraph_integer_t i = current; i < current + nbuckets && next < 0; ++i)
+            for (auto &b : buckets)
+                if (! b[i % nbuckets].empty())
+                    next = i;
+        if (next < 0)
+            break;
+        current = next;
+
+        // Move its contents to the shared frontier.
+        const igraph_integer_t slot = current % nbuckets;
+        offsets[0] = 0;
+        for (std::size_t t = 0; t < buckets.size(); ++t)
+            offsets[t + 1] = offsets[t] + buckets[t][slot].size();
+        frontier.resize(offsets.back());
+        detail::parallel_threads([&](unsigned tid) {
+            std::copy(buckets[tid][slot].begin(), buckets[tid][slot].end(), frontier.begin() + offsets[tid]);
+            buckets[tid][slot].clear();
+        });
+
+        detail::parallel_for(frontier.size(), 64, [&](igraph_integer_t begin, igraph_integer_t end, unsigned tid) {
+            for (igraph_integer_t i = begin; i < end; ++i) {
+                const igraph_integer_t v = frontier[i];
+                const igraph_real_t dv = d[v].load(std::memory_order_relaxed);
+                if (bucket_of(dv) != current)
+                    continue;
+                g.for_each_neighbor(v, mode, [&](igraph_integer_t u, igraph_integer_t e) {
+                    const igraph_real_t w = weights[e];
+                    if (w == IGRAPH_INFINITY)
+                        return;
+                    const igraph_real_t du = dv + w;
+                    if (detail::atomic_fetch_min(d[u], du))
+                        buckets[tid][bucket_of(du) % nbuckets].push_back(u);
+                });
+            }
+        });
+    }
+
+    dist.resize(n);
+    detail::parallel_for(n, 1 << 12, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+        for (igraph_integer_t v = begin; v < end; ++v)
+            dist[v] = d[v].load(std::memory_order_relaxed);
+    });
+
+    if (pred)
+        detail::shortest_path_predecessors(g, source, weights, dist, *pred, mode);
+}
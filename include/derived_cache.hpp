@@ -0,0 +1,107 @@
+
+// Memoization of data derived from a graph.
+//
+// igraph caches a few boolean properties of each graph, such as whether it is simple or
+// connected. DerivedCache extends this to arbitrary, possibly large, results computed
+// from a Graph: degree vectors, neighbour lists, components, coreness, compact copies
+// of its structure, or any value produced by a user-supplied function. Each result is
+// computed on first use, and stored under a key naming its kind and parameters. When
+// the version of the graph changes (see Graph::version()), all stored results are
+// dropped, and are recomputed on their next use.
+//
+// DerivedCache is not thread-safe: concurrent calls must be synchronized externally.
+
+class DerivedCache {
+    struct Entry {
+        const std::type_info *type;
+        std::shared_ptr<void> value;
+    };
+
+    const Graph *graph;
+    std::uint64_t version;
+    std::unordered_map<std::string, Entry> entries;
+    igraph_integer_t hit_count = 0, miss_count = 0;
+
+public:
+    // Caches results derived from 'graph', which must outlive the cache.
+    explicit DerivedCache(const Graph &graph_) : graph(&graph_), version(graph_.version()) { }
+
+    DerivedCache(const DerivedCache &) = delete;
+    DerivedCache & operator = (const DerivedCache &) = delete;
+
+    // Returns the result stored under 'key', calling compute(graph) to create it if it is
+    // missing, or if the graph changed since it was stored. The result must be of type T,
+    // and be requested with the same type every time. The reference remains valid until
+    // the graph changes, or clear() is called.
+    template<typename T, typename F>
+    const T &get(const std::string &key, F &&compute) {
+        if (graph->version() != version) {
+            entries.clear();
+            version = graph->version();
+        }
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            if (*it->second.type != typeid(T))
+                throw Exception(IGRAPH_EINVAL);
+            ++hit_count;
+            return *static_cast<const T *>(it->second.value.get());
+        }
+        ++miss_count;
+        std::shared_ptr<T> value = std::make_shared<T>(compute(*graph));
+        entries[key] = Entry{&typeid(T), value};
+        return *value;
+    }
+
+    // The number of calls that found a stored result, and that computed a new one.
+    igraph_integer_t hits() const { return hit_count; }
+    igraph_integer_t misses() const { return miss_count; }
+
+    // The number of stored results.
+    igraph_integer_t size() const { return entries.size(); }
+
+    // Drops all stored results.
+    void clear() { entries.clear(); }
+
+    // Common derived data.
+
+    // Vertex degrees, as computed by igraph_degree().
+    const IntVec &degree(igraph_neimode_t mode = IGRAPH_ALL, bool loops = true) {
+        return get<IntVec>("degree/" + std::to_string(mode) + "/" + std::to_string(loops), [&](const Graph &g) {
+            IntVec res;
+            check(igraph_degree(g, res, igraph_vss_all(), mode, loops));
+            return res;
+        });
+    }
+
+    // The sorted neighbour list of each vertex, as computed by igraph_neighbors().
+    const IntVecList &neighbors(igraph_neimode_t mode = IGRAPH_ALL) {
+        return get<IntVecList>("neighbors/" + std::to_string(mode), [&](const Graph &g) {
+            IntVecList res(g.vcount());
+            for (igraph_integer_t v = 0; v < g.vcount(); ++v)
+                check(igraph_neighbors(g, res[v], v, mode));
+            return res;
+        });
+    }
+
+    // See connected_components().
+    const Components &components() {
+        return get<Components>("components", [](const Graph &g) {
+            return connected_components(g);
+        });
+    }
+
+    // See ig::coreness().
+    const IntVec &coreness(igraph_neimode_t mode = IGRAPH_ALL) {
+        return get<IntVec>("coreness/" + std::to_string(mode), [&](const Graph &g) {
+            return ig::coreness(g, mode);
+        });
+    }
+
+    // A CSRGraph copy of the graph, for faster traversals.
+    template<typename Index = std::int32_t>
+    const CSRGraph<Index> &csr() {
+        return get<CSRGraph<Index>>(std::string("csr/") + typeid(Index).name(), [](const Graph &g) {
+            return CSRGraph<Index>(g);
+        });
+    }
+};
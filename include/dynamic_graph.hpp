@@ -0,0 +1,299 @@
+
+// Graphs with batched edge updates.
+//
+// Each call to igraph_add_edges() or igraph_delete_edges() rebuilds the edge indices of
+// an igraph_t, so applying a stream of single-edge updates takes quadratic time.
+// DynamicGraph instead keeps a base Graph and a delta: added edges are appended to
+// per-vertex lists, and deleted edges are marked in a tombstone array. Reads merge the
+// base graph and the delta on the fly. Compacting the delta rebuilds the igraph_t in a
+// single pass, and clears the delta, so that the cost of rebuilding is amortized over
+// many updates. Compaction happens when commit() or graph() is called, or, if enabled
+// with set_compaction_threshold(), at the end of an update once the delta grows beyond
+// a fraction of the base graph.
+//
+// DynamicGraph implements the interface of GraphView, so the algorithms of igraph-cpp
+// can run on it between updates. Edge IDs are those of the base graph, followed by
+// the added edges in order. Deleted edges keep their IDs until the next compaction, so
+// ecount() is the number of edge IDs, including deleted edges, and arrays indexed by
+// edge ID, such as weights, have that size. Compaction renumbers the remaining edges
+// consecutively, in order, as igraph_delete_edges() does. Updates that compact the
+// delta report it, and can return the mapping of edge IDs.
+
+class DynamicGraph;
+inline const DynamicGraph &view(const DynamicGraph &graph);
+
+class DynamicGraph {
+    Graph base;
+    igraph_integer_t base_n, base_m;
+    igraph_integer_t n, live;
+    igraph_real_t threshold = -1;
+
+    // Endpoints of added edges, with IDs base_m, base_m + 1, ...
+    std::vector<igraph_integer_t> added_from, added_to;
+    // The IDs of the added edges, by source and by target, including deleted ones, which
+    // are skipped when iterating, so that deleting an edge takes constant time.
+    std::vector<std::vector<igraph_integer_t>> out_added, in_added;
+    // Deleted edges, by ID, the number of deleted edges by source and by target, and the
+    // number of deleted edges of the base graph.
+    std::vector<char> deleted;
+    std::vector<igraph_integer_t> out_deleted, in_deleted;
+    igraph_integer_t deleted_count = 0;
+
+    // Connectivity, if tracked; stale after deletions.
+    std::unique_ptr<ConnectivityTracker> tracker;
+    bool tracker_stale = false;
+
+    GraphView base_view() const { return GraphView(base); }
+
+    void reset() {
+        base_n = n = base.vcount();
+        base_m = live = base.ecount();
+        added_from.clear();
+        added_to.clear();
+        out_added.assign(n, {});
+        in_added.assign(n, {});
+        deleted.assign(base_m, false);
+        out_deleted.assign(n, 0);
+        in_deleted.assign(n, 0);
+        deleted_count = 0;
+    }
+
+    igraph_integer_t delta_size() const {
+        return igraph_integer_t(added_from.size()) + deleted_count;
+    }
+
+    // Compacts the delta if it exceeds the threshold, and returns whether it did. Called
+    // once at the end of each update, never in the middle of a batch.
+    bool maybe_compact(IntVec *edge_map) {
+        if (threshold < 0 || delta_size() <= threshold * std::max<igraph_integer_t>(base_m, 1024)) {
+            if (edge_map)
+                edge_map->clear();
+            return false;
+        }
+        commit(edge_map);
+        return true;
+    }
+
+    void check_vertex(igraph_integer_t v) const {
+        if (v < 0 || v >= n)
+            throw Exception(IGRAPH_EINVVID);
+    }
+
+    igraph_integer_t push_edge(igraph_integer_t from, igraph_integer_t to) {
+        if (! is_directed() && from < to)
+            std::swap(from, to);
+        const igraph_integer_t e = ecount();
+        added_from.push_back(from);
+        added_to.push_back(to);
+        deleted.push_back(false);
+        out_added[from].push_back(e);
+        in_added[to].push_back(e);
+        ++live;
+        if (tracker && ! tracker_stale)
+            tracker->add_edge(from, to);
+        return e;
+    }
+
+    void mark_deleted(igraph_integer_t e) {
+        deleted[e] = true;
+        --live;
+        tracker_stale = true;
+        out_deleted[from(e)]++;
+        in_deleted[to(e)]++;
+        if (e < base_m)
+            ++deleted_count;
+    }
+
+public:
+    // Takes over the graph given as the initial state.
+    explicit DynamicGraph(Graph graph) : base(std::move(graph)) {
+        reset();
+    }
+
+    explicit DynamicGraph(igraph_integer_t n = 0, bool directed = false) : base(n, directed) {
+        reset();
+    }
+
+    DynamicGraph(const DynamicGraph &) = delete;
+    DynamicGraph & operator = (const DynamicGraph &) = delete;
+
+    // Enables automatic compaction: at the end of an update, the delta is compacted if
+    // it holds more updates than 'fraction' times the number of edges of the base graph,
+    // or of 1024 for small graphs. 0.25 is a good choice for streams of updates. A
+    // negative fraction, the default, disables automatic compaction, so that edge IDs
+    // only change when commit() or graph() is called.
+    void set_compaction_threshold(igraph_real_t fraction) { threshold = fraction; }
+
+    igraph_integer_t vcount() const { return n; }
+    igraph_integer_t ecount() const { return base_m + igraph_integer_t(added_from.size()); }
+    bool is_directed() const { return base.is_directed(); }
+
+    // The number of edges that are not deleted.
+    igraph_integer_t live_ecount() const { return live; }
+
+    bool is_deleted(igraph_integer_t e) const { return deleted[e]; }
+
+    // Edge endpoints, also for deleted edges, which algorithms looking up edges by ID
+    // skip using is_deleted(). For undirected graphs, from(e) >= to(e).
+    igraph_integer_t from(igraph_integer_t e) const {
+        return e < base_m ? base_view().from(e) : added_from[e - base_m];
+    }
+    igraph_integer_t to(igraph_integer_t e) const {
+        return e < base_m ? base_view().to(e) : added_to[e - base_m];
+    }
+
+    // Adds 'count' isolated vertices.
+    void add_vertices(igraph_integer_t count) {
+        if (count < 0)
+            throw Exception(IGRAPH_EINVAL);
+        n += count;
+        if (tracker)
+            tracker->add_vertices(count);
+        out_added.resize(n);
+        in_added.resize(n);
+        out_deleted.resize(n, 0);
+        in_deleted.resize(n, 0);
+    }
+
+    // Adds an edge, and returns its ID. If the update compacts the delta, this is the ID
+    // after compaction, where the new edge is the last edge, and 'edge_map', if given,
+    // receives the new ID of each edge, as in commit(). Otherwise 'edge_map' is cleared;
+    // the other update functions treat it in the same way.
+    igraph_integer_t add_edge(igraph_integer_t from, igraph_integer_t to, IntVec *edge_map = nullptr) {
+        check_vertex(from);
+        check_vertex(to);
+        const igraph_integer_t e = push_edge(from, to);
+        if (maybe_compact(edge_map))
+            return ecount() - 1;
+        return e;
+    }
+
+    // Adds edges given as consecutive pairs of vertex IDs. They become the last edges,
+    // whether or not the delta is compacted. Returns whether it was compacted.
+    bool add_edges(const IntVec &edges, IntVec *edge_map = nullptr) {
+        if (edges.size() % 2 != 0)
+            throw Exception(IGRAPH_EINVAL);
+        for (auto v : edges)
+            check_vertex(v);
+        for (igraph_integer_t i = 0; i < edges.size(); i += 2)
+            push_edge(edges[i], edges[i + 1]);
+        return maybe_compact(edge_map);
+    }
+
+    // Deletes an edge. The IDs of the other edges do not change unless the delta is
+    // compacted. Returns whether it was compacted.
+    bool delete_edge(igraph_integer_t e, IntVec *edge_map = nullptr) {
+        if (e < 0 || e >= ecount() || deleted[e])
+            throw Exception(IGRAPH_EINVAL);
+        mark_deleted(e);
+        return maybe_compact(edge_map);
+    }
+
+    // Deletes edges given by their IDs, which may repeat. All IDs refer to the state
+    // before the call; if any is invalid or already deleted, nothing is deleted.
+    bool delete_edges(const IntVec &eids, IntVec *edge_map = nullptr) {
+        for (auto e : eids)
+            if (e < 0 || e >= ecount() || deleted[e])
+                throw Exception(IGRAPH_EINVAL);
+        for (auto e : eids)
+            if (! deleted[e])
+                mark_deleted(e);
+        return maybe_compact(edge_map);
+    }
+
+    // Rebuilds the base graph with all updates applied, and clears the delta. Edges are
+    // renumbered consecutively, in order. If 'edge_map' is given, it receives the new ID
+    // of each edge, or -1 for deleted edges.
+    void commit(IntVec *edge_map = nullptr) {
+        const igraph_integer_t m = ecount();
+        IntVec edges(2 * live);
+        if (edge_map)
+            edge_map->resize(m);
+        for (igraph_integer_t e = 0, k = 0; e < m; ++e) {
+            if (edge_map)
+                (*edge_map)[e] = deleted[e] ? -1 : k;
+            if (deleted[e])
+                continue;
+            edges[2 * k] = from(e);
+            edges[2 * k + 1] = to(e);
+            ++k;
+        }
+        Graph rebuilt(edges, n, is_directed());
+        swap(base, rebuilt);
+        reset();
+    }
+
+    // The graph with all updates applied, compacting the delta if needed.
+    const Graph &graph() {
+        if (delta_size() > 0 || n > base_n)
+            commit();
+        return base;
+    }
+
+    // Starts maintaining the connected components of the graph, or stops if 'enable' is
+    // false. See connectivity().
+    void track_connectivity(bool enable = true) {
+        if (enable) {
+            tracker.reset(new ConnectivityTracker(*this));
+            tracker_stale = false;
+        } else {
+            tracker.reset();
+        }
+    }
+
+    // The connected components of the graph, which are updated as edges are added, and
+    // recomputed after edges were deleted. Connectivity must be tracked.
+    const ConnectivityTracker &connectivity() {
+        if (! tracker)
+            throw Exception(IGRAPH_EINVAL);
+        if (tracker_stale) {
+            tracker->rebuild(*this);
+            tracker_stale = false;
+        }
+        return *tracker;
+    }
+
+    igraph_integer_t degree(igraph_integer_t v, igraph_neimode_t mode = IGRAPH_OUT) const {
+        if (! is_directed())
+            mode = IGRAPH_ALL;
+        igraph_integer_t deg = 0;
+        if (mode & IGRAPH_OUT)
+            deg += igraph_integer_t(out_added[v].size()) - out_deleted[v];
+        if (mode & IGRAPH_IN)
+            deg += igraph_integer_t(in_added[v].size()) - in_deleted[v];
+        if (v < base_n)
+            deg += base_view().degree(v, mode);
+        return deg;
+    }
+
+    // See GraphView::for_each_neighbor(). Neighbours in the base graph are visited
+    // first, then those connected by added edges.
+    template<typename F>
+    bool for_each_neighbor(igraph_integer_t v, igraph_neimode_t mode, F &&f) const {
+        if (! is_directed())
+            mode = IGRAPH_ALL;
+        if (v < base_n) {
+            const bool filter = deleted_count > 0;
+            const bool done = base_view().for_each_neighbor(v, mode, [&](igraph_integer_t u, igraph_integer_t e) {
+                if (filter && deleted[e])
+                    return true;
+                return detail::invoke_continue(f, u, e);
+            });
+            if (! done)
+                return false;
+        }
+        if (mode & IGRAPH_OUT) {
+            for (auto e : out_added[v])
+                if (! deleted[e] && ! detail::invoke_continue(f, added_to[e - base_m], e))
+                    return false;
+        }
+        if (mode & IGRAPH_IN) {
+            for (auto e : in_added[v])
+                if (! deleted[e] && ! detail::invoke_continue(f, added_from[e - base_m], e))
+                    return false;
+        }
+        return true;
+    }
+};
+
+inline const DynamicGraph &view(const DynamicGraph &graph) { return graph; }
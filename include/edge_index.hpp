@@ -0,0 +1,232 @@
+
+// Constant-time edge lookup.
+//
+// igraph_get_eid() finds an edge by binary search in the sorted incidence list of one of
+// its endpoints, which takes several dependent cache misses at high-degree vertices.
+// EdgeIndex instead stores the edges in an open-addressing hash table keyed on the
+// packed (from, to) vertex pair. The table is divided into buckets of one cache line,
+// holding four (key, edge ID) slots each, and collisions are resolved by probing the
+// next bucket, so that most lookups read a single cache line.
+//
+// When most queried pairs are not connected, and the table is larger than the caches,
+// an optional blocked Bloom filter answers most negative queries from a smaller
+// structure: each key sets 8 bits within a single cache line, using 16 bits per edge.
+//
+// Batched lookups compute the buckets of a group of pairs first and prefetch them, so
+// that the memory accesses of the group overlap, and split large batches among threads.
+
+namespace detail {
+
+inline void prefetch(const void *p) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#else
+    (void) p;
+#endif
+}
+
+// The first 64-byte aligned element of a buffer of 64-bit words, which must have
+// 7 extra elements.
+template<typename T>
+T *cache_line_align(T *p) {
+    static_assert(sizeof(T) == 8, "cache_line_align requires 64-bit elements.");
+    return reinterpret_cast<T *>((reinterpret_cast<std::uintptr_t>(p) + 63) & ~std::uintptr_t(63));
+}
+
+} // namespace detail
+
+class EdgeIndex {
+    static constexpr std::uint64_t empty = ~std::uint64_t(0);
+    static constexpr int bucket_slots = 4;
+    static constexpr int bucket_words = 2 * bucket_slots;
+    static constexpr int bloom_words = 8;
+    static constexpr igraph_integer_t group = 16;
+
+    igraph_integer_t n = 0, m = 0;
+    bool directed = false;
+
+    // Bucket b occupies words [8 b, 8 b + 8) of the aligned table: key, edge ID, ...
+    std::vector<std::uint64_t> table;
+    std::uint64_t bucket_mask = 0;
+
+    // Block b of the Bloom filter occupies words [8 b, 8 b + 8); empty if not used.
+    std::vector<std::uint64_t> bloom;
+    std::uint64_t bloom_mask = 0;
+
+    static std::uint64_t hash(std::uint64_t key) {
+        key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9;
+        key = (key ^ (key >> 27)) * 0x94d049bb133111eb;
+        return key ^ (key >> 31);
+    }
+
+    std::uint64_t make_key(igraph_integer_t from, igraph_integer_t to) const {
+        if (! directed && from < to)
+            std::swap(from, to);
+        return (std::uint64_t(from) << 32) | std::uint64_t(to);
+    }
+
+    std::uint64_t *bucket(std::uint64_t b) {
+        return detail::cache_line_align(table.data()) + bucket_words * b;
+    }
+    const std::uint64_t *bucket(std::uint64_t b) const {
+        return detail::cache_line_align(table.data()) + bucket_words * b;
+    }
+
+    std::uint64_t *bloom_block(std::uint64_t h) {
+        return detail::cache_line_align(bloom.data()) + bloom_words * ((h >> 32) & bloom_mask);
+    }
+    const std::uint64_t *bloom_block(std::uint64_t h) const {
+        return detail::cache_line_align(bloom.data()) + bloom_words * ((h >> 32) & bloom_mask);
+    }
+
+    // The bit of each word of a Bloom filter block set by a key, 6 bits of the hash each.
+    static std::uint64_t bloom_bit(std::uint64_t h, int word) {
+        return std::uint64_t(1) << ((h * 0x9e3779b97f4a7c15 >> (6 * word + 16)) & 63);
+    }
+
+    bool bloom_contains(std::uint64_t h) const {
+        const std::uint64_t *block = bloom_block(h);
+        std::uint64_t missing = 0;
+        for (int i = 0; i < bloom_words; ++i)
+            missing |= bloom_bit(h, i) & ~block[i];
+        return missing == 0;
+    }
+
+    void insert(std::uint64_t key, igraph_integer_t eid) {
+        const std::uint64_t h = hash(key);
+        if (! bloom.empty()) {
+            std::uint64_t *block = bloom_block(h);
+            for (int i = 0; i < bloom_words; ++i)
+                block[i] |= bloom_bit(h, i);
+        }
+        for (std::uint64_t b = h & bucket_mask; ; b = (b + 1) & bucket_mask) {
+            std::uint64_t *slots = bucket(b);
+            for (int i = 0; i < bucket_slots; ++i) {
+                // Of multiple edges, the one with the smallest ID is kept.
+                if (slots[2 * i] == key)
+                    return;
+                if (slots[2 * i] == empty) {
+                    slots[2 * i] = key;
+                    slots[2 * i + 1] = std::uint64_t(eid);
+                    return;
+                }
+            }
+        }
+    }
+
+    igraph_integer_t lookup(std::uint64_t key, std::uint64_t h) const {
+        if (! bloom.empty() && ! bloom_contains(h))
+            return -1;
+        for (std::uint64_t b = h & bucket_mask; ; b = (b + 1) & bucket_mask) {
+            const std::uint64_t *slots = bucket(b);
+            for (int i = 0; i < bucket_slots; ++i) {
+                if (slots[2 * i] == key)
+                    return igraph_integer_t(slots[2 * i + 1]);
+                if (slots[2 * i] == empty)
+                    return -1;
+            }
+        }
+    }
+
+    // Looks up the pair (from, to), whose key and hash are given, and, for undirected
+    // queries in directed graphs, the reverse pair, returning the smaller ID.
+    igraph_integer_t find_key(igraph_integer_t from, igraph_integer_t to,
+                              std::uint64_t key, std::uint64_t h, bool directed) const {
+        igraph_integer_t eid = lookup(key, h);
+        if (! directed && this->directed && from != to) {
+            const std::uint64_t rkey = make_key(to, from);
+            const igraph_integer_t reid = lookup(rkey, hash(rkey));
+            if (reid >= 0 && (eid < 0 || reid < eid))
+                eid = reid;
+        }
+        return eid;
+    }
+
+    void check_vertex(igraph_integer_t v) const {
+        if (v < 0 || v >= n)
+            throw Exception(IGRAPH_EINVVID);
+    }
+
+public:
+    // Indexes the edges of a graph, which may be a Graph or any of its views providing
+    // edge endpoints. The Bloom filter speeds up queries that mostly find no edge.
+    // Throws IGRAPH_EOVERFLOW for graphs with 2^32 - 1 or more vertices.
+    template<typename G, typename = decltype(view(std::declval<const G &>()).from(0))>
+    explicit EdgeIndex(const G &graph, bool bloom_filter = false) {
+        auto &&g = view(graph);
+        n = g.vcount();
+        m = g.ecount();
+        directed = g.is_directed();
+        if (std::uint64_t(n) >= 0xffffffff)
+            throw Exception(IGRAPH_EOVERFLOW);
+
+        // At most half of the slots are used.
+        std::uint64_t buckets = 1;
+        while (buckets * bucket_slots < 2 * std::uint64_t(m))
+            buckets *= 2;
+        bucket_mask = buckets - 1;
+        table.assign(buckets * bucket_words + 7, std::uint64_t(empty));
+
+        if (bloom_filter) {
+            std::uint64_t blocks = 1;
+            while (blocks * bloom_words * 64 < 16 * std::uint64_t(m))
+                blocks *= 2;
+            bloom_mask = blocks - 1;
+            bloom.assign(blocks * bloom_words + 7, 0);
+        }
+
+        for (igraph_integer_t e = 0; e < m; ++e)
+            if (! detail::edge_deleted(g, e, 0))
+                insert(make_key(g.from(e), g.to(e)), e);
+    }
+
+    igraph_integer_t vcount() const { return n; }
+    igraph_integer_t ecount() const { return m; }
+    bool is_directed() const { return directed; }
+
+    // The memory used by the index, in bytes.
+    std::size_t memory_size() const {
+        return sizeof(std::uint64_t) * (table.size() + bloom.size());
+    }
+
+    // The ID of an edge from 'from' to 'to', or -1 if there is none. With multiple
+    // edges, the smallest ID is returned. If 'directed' is false, or the graph is
+    // undirected, edges from 'to' to 'from' are also considered, and the smallest ID
+    // in either direction is returned; in directed graphs, this takes two lookups.
+    igraph_integer_t find(igraph_integer_t from, igraph_integer_t to, bool directed = true) const {
+        check_vertex(from);
+        check_vertex(to);
+        const std::uint64_t key = make_key(from, to);
+        return find_key(from, to, key, hash(key), directed);
+    }
+
+    bool contains(igraph_integer_t from, igraph_integer_t to, bool directed = true) const {
+        return find(from, to, directed) >= 0;
+    }
+
+    // Finds the edges between the vertex pairs given consecutively in 'pairs', as
+    // igraph_get_eids() does, using multiple threads. Element i of 'res' is the ID of the
+    // edge between pairs[2 i] and pairs[2 i + 1], or -1 if there is none.
+    void find(const IntVec &pairs, IntVec &res, bool directed = true) const {
+        if (pairs.size() % 2 != 0)
+            throw Exception(IGRAPH_EINVAL);
+        for (auto v : pairs)
+            check_vertex(v);
+        const igraph_integer_t count = pairs.size() / 2;
+        res.resize(count);
+
+        detail::parallel_for(count, 1 << 12, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            std::uint64_t keys[group], hashes[group];
+            for (igraph_integer_t first = begin; first < end; first += group) {
+                const igraph_integer_t size = end - first < group ? end - first : group;
+                for (igraph_integer_t i = 0; i < size; ++i) {
+                    keys[i] = make_key(pairs[2 * (first + i)], pairs[2 * (first + i) + 1]);
+                    hashes[i] = hash(keys[i]);
+                    detail::prefetch(bloom.empty() ? bucket(hashes[i] & bucket_mask) : bloom_block(hashes[i]));
+                }
+                for (igraph_integer_t i = 0; i < size; ++i)
+                    res[first + i] = find_key(pairs[2 * (first + i)], pairs[2 * (first + i) + 1], keys[i], hashes[i], directed);
+            }
+        });
+    }
+};
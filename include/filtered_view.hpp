@@ -0,0 +1,116 @@
+
+// Subgraph views without copying.
+//
+// FilteredView restricts a graph to the vertices and edges selected by bit masks, such
+// as the vertices of a community, or the edges of a time window. It implements the
+// interface of GraphView, so it can be passed to the algorithms of igraph-cpp in place
+// of a Graph: neighbour iteration skips the edges that are not selected, as well as the
+// edges leading to vertices that are not selected.
+//
+// Vertex and edge IDs are those of the underlying graph, so that results, and edge
+// weights, are indexed as for the full graph. vcount() and ecount() therefore return
+// the number of vertices and edges of the underlying graph; vertices that are not
+// selected appear isolated. Use materialize() to create the subgraph as a Graph.
+
+class FilteredView {
+    GraphView graph;
+    const igraph_bitset_t *vertex_mask, *edge_mask;
+
+public:
+    // Views the subgraph of 'graph' made of the vertices set in 'vertices', and the
+    // edges set in 'edges', which must have vcount() and ecount() bits respectively.
+    // A null mask selects all vertices or edges. The masks are not copied, and must
+    // outlive the view.
+    FilteredView(const igraph_t *graph_, const Bitset *vertices, const Bitset *edges = nullptr) :
+        graph(graph_),
+        vertex_mask(vertices ? static_cast<const igraph_bitset_t *>(*vertices) : nullptr),
+        edge_mask(edges ? static_cast<const igraph_bitset_t *>(*edges) : nullptr) {
+        if (vertices && vertices->size() != graph.vcount())
+            throw Exception(IGRAPH_EINVAL);
+        if (edges && edges->size() != graph.ecount())
+            throw Exception(IGRAPH_EINVAL);
+    }
+
+    igraph_integer_t vcount() const { return graph.vcount(); }
+    igraph_integer_t ecount() const { return graph.ecount(); }
+    bool is_directed() const { return graph.is_directed(); }
+
+    bool has_vertex(igraph_integer_t v) const {
+        return ! vertex_mask || IGRAPH_BIT_TEST(*vertex_mask, v);
+    }
+
+    // Whether edge e is part of the subgraph: it is selected, and so are its endpoints.
+    bool has_edge(igraph_integer_t e) const {
+        return (! edge_mask || IGRAPH_BIT_TEST(*edge_mask, e)) &&
+               has_vertex(graph.from(e)) && has_vertex(graph.to(e));
+    }
+
+    // The number of edges of the subgraph incident on v. This takes time proportional
+    // to the degree of v in the underlying graph.
+    igraph_integer_t degree(igraph_integer_t v, igraph_neimode_t mode = IGRAPH_OUT) const {
+        if (! vertex_mask && ! edge_mask)
+            return graph.degree(v, mode);
+        igraph_integer_t deg = 0;
+        for_each_neighbor(v, mode, [&](igraph_integer_t, igraph_integer_t) {
+            ++deg;
+        });
+        return deg;
+    }
+
+    // See GraphView::for_each_neighbor().
+    template<typename F>
+    bool for_each_neighbor(igraph_integer_t v, igraph_neimode_t mode, F &&f) const {
+        if (! has_vertex(v))
+            return true;
+        return graph.for_each_neighbor(v, mode, [&](igraph_integer_t u, igraph_integer_t e) {
+            if ((edge_mask && ! IGRAPH_BIT_TEST(*edge_mask, e)) || ! has_vertex(u))
+                return true;
+            return detail::invoke_continue(f, u, e);
+        });
+    }
+
+    // Creates the subgraph as a Graph. Vertices and edges are renumbered consecutively,
+    // in the order of their IDs. If 'vertex_ids' or 'edge_ids' is given, it receives the
+    // ID in the underlying graph of each vertex or edge of the subgraph.
+    Graph materialize(IntVec *vertex_ids = nullptr, IntVec *edge_ids = nullptr) const {
+        const igraph_integer_t n = vcount(), m = ecount();
+
+        IntVec index(n);
+        igraph_integer_t count = 0;
+        for (igraph_integer_t v = 0; v < n; ++v)
+            index[v] = has_vertex(v) ? count++ : -1;
+
+        IntVec edges;
+        if (vertex_ids) {
+            vertex_ids->clear();
+            vertex_ids->reserve(count);
+            for (igraph_integer_t v = 0; v < n; ++v)
+                if (index[v] >= 0)
+                    vertex_ids->push_back(v);
+        }
+        if (edge_ids)
+            edge_ids->clear();
+        for (igraph_integer_t e = 0; e < m; ++e) {
+            if (! has_edge(e))
+                continue;
+            edges.push_back(index[graph.from(e)]);
+            edges.push_back(index[graph.to(e)]);
+            if (edge_ids)
+                edge_ids->push_back(e);
+        }
+        return Graph(edges, count, is_directed());
+    }
+};
+
+inline const FilteredView &view(const FilteredView &graph) { return graph; }
+
+// A mask of 'size' bits in which the given IDs are set, for use with FilteredView.
+inline Bitset make_mask(igraph_integer_t size, const IntVec &ids) {
+    Bitset mask(size);
+    for (auto id : ids) {
+        if (id < 0 || id >= size)
+            throw Exception(IGRAPH_EINVAL);
+        mask[id] = true;
+    }
+    return mask;
+}
@@ -0,0 +1,130 @@
+
+// Blocked, multi-threaded Floyd-Warshall algorithm for all-pairs shortest paths.
+//
+// The distance matrix is divided into square tiles. In each round, the diagonal tile
+// of the current block column is closed first, then the tiles sharing its block row or
+// column are updated from it, and finally all remaining tiles are updated from those.
+// The tiles within the last two phases are independent and processed in parallel.
+// Each tile update is a min-plus product over a few tiles, which stays in cache.
+//
+// Matrices are column-major, so the innermost loop runs down a column, over contiguous
+// memory. It is written so that the compiler can vectorize it.
+
+namespace detail {
+
+constexpr igraph_integer_t floyd_warshall_block_size = 64;
+
+// Sets C[i, j] = min(C[i, j], A[i, k] + B[k, j]) for each k < depth in turn, for
+// the rows x cols tile C, rows x depth tile A and depth x cols tile B of a matrix with
+// leading dimension ld. A or B may coincide with C.
+inline void min_plus_tile(igraph_real_t *C, const igraph_real_t *A, const igraph_real_t *B,
+                          igraph_integer_t rows, igraph_integer_t cols, igraph_integer_t depth,
+                          igraph_integer_t ld) {
+    for (igraph_integer_t k = 0; k < depth; ++k) {
+        const igraph_real_t *a = A + k * ld;
+        for (igraph_integer_t j = 0; j < cols; ++j) {
+            const igraph_real_t b = B[k + j * ld];
+            igraph_real_t *c = C + j * ld;
+            for (igraph_integer_t i = 0; i < rows; ++i) {
+                const igraph_real_t s = a[i] + b;
+                c[i] = s < c[i] ? s : c[i];
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+// Replaces the square matrix 'dist' of edge lengths, where dist(i, j) is the length of
+// the edge from i to j (IGRAPH_INFINITY if there is none, zero on the diagonal), with the
+// matrix of shortest path lengths, using multiple threads. Negative lengths are allowed,
+// but throws an Exception if there is a negative cycle.
+inline void floyd_warshall(RealMat &dist) {
+    const igraph_integer_t n = dist.nrow();
+    if (dist.ncol() != n)
+        throw Exception(IGRAPH_NONSQUARE);
+
+    const igraph_integer_t bs = detail::floyd_warshall_block_size;
+    const igraph_integer_t nb = (n + bs - 1) / bs;
+    igraph_real_t *D = dist.data();
+
+    auto tile = [&](igraph_integer_t bi, igraph_integer_t bj) { return D + bi * bs + bj * bs * n; };
+    auto extent = [&](igraph_integer_t b) { return std::min(bs, n - b * bs); };
+
+    for (igraph_integer_t k = 0; k < nb; ++k) {
+        igraph_real_t *diag = tile(k, k);
+        const igraph_integer_t kn = extent(k);
+
+        detail::min_plus_tile(diag, diag, diag, kn, kn, kn, n);
+
+        // Tiles in block row k and block column k. Those with index k < nb are in the row.
+        detail::parallel_for(2 * nb, 1, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            for (igraph_integer_t t = begin; t < end; ++t) {
+                const igraph_integer_t b = t % nb;
+                if (b == k)
+                    continue;
+                if (t < nb) {
+                    igraph_real_t *C = tile(k, b);
+                    detail::min_plus_tile(C, diag, C, kn, extent(b), kn, n);
+                } else {
+                    igraph_real_t *C = tile(b, k);
+                    detail::min_plus_tile(C, C, diag, extent(b), kn, kn, n);
+                }
+            }
+        });
+
+        detail::parallel_for(nb * nb, 1, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            for (igraph_integer_t t = begin; t < end; ++t) {
+                const igraph_integer_t bi = t % nb, bj = t / nb;
+                if (bi == k || bj == k)
+                    continue;
+                detail::min_plus_tile(tile(bi, bj), tile(bi, k), tile(k, bj), extent(bi), extent(bj), kn, n);
+            }
+        });
+    }
+
+    for (igraph_integer_t i = 0; i < n; ++i)
+        if (dist(i, i) < 0)
+            throw Exception(IGRAPH_ENEGLOOP);
+}
+
+// Computes the lengths of shortest paths between all pairs of vertices using the blocked
+// Floyd-Warshall algorithm, and stores them in 'res', with sources in rows. Suitable
+// for dense graphs. If 'weights' is null, each edge has length one; negative weights are
+// allowed. The mode determines whether edges are followed in their own direction
+// (IGRAPH_OUT), in reverse (IGRAPH_IN) or both ways (IGRAPH_ALL).
+template<typename G>
+void distances_floyd_warshall(const G &graph, RealMat &res, const RealVec *weights = nullptr,
+                              igraph_neimode_t mode = IGRAPH_OUT) {
+    auto &&g = view(graph);
+    const igraph_integer_t n = g.vcount();
+
+    detail::check_mode(mode);
+    if (weights) {
+        detail::check_edge_weights(g, *weights);
+        for (auto w : *weights)
+            if (std::isnan(w))
+                throw Exception(IGRAPH_EINVAL);
+    }
+
+    res.resize(n, n);
+    detail::parallel_for(n, 64, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+        for (igraph_integer_t j = begin; j < end; ++j) {
+            std::fill(&res(0, j), &res(0, j) + n, IGRAPH_INFINITY);
+            res(j, j) = 0;
+        }
+    });
+
+    // Each thread fills its own rows; with multi-edges, the shortest one counts.
+    detail::parallel_for(n, 64, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+        for (igraph_integer_t v = begin; v < end; ++v) {
+            g.for_each_neighbor(v, mode, [&](igraph_integer_t u, igraph_integer_t e) {
+                const igraph_real_t w = weights ? (*weights)[e] : 1;
+                if (w < res(v, u))
+                    res(v, u) = w;
+            });
+        }
+    });
+
+    floyd_warshall(res);
+}
@@ -7,6 +7,9 @@ private:
     igraph_t graph;
     igraph_t *ptr = &graph;
 
+    // Incremented on each modification made through the wrapper, see version().
+    mutable std::uint64_t ver = 0;
+
     bool is_alias() const { return ptr != &graph; }
 
     friend class GraphList;
@@ -43,6 +46,7 @@ public:
     Graph & operator = (const Graph &) = delete;
 
     Graph & operator = (Graph &&other) && noexcept {
+        ++ver;
         if (! is_alias())
             igraph_destroy(ptr);
         if (other.is_alias()) {
@@ -56,6 +60,7 @@ public:
     }
 
     Graph & operator = (CaptureType<igraph_t> g) {
+        ++ver;
         if (! is_alias())
             igraph_destroy(ptr);
         graph = g.obj;
@@ -64,6 +69,7 @@ public:
     }
 
     Graph & operator = (AliasType<igraph_t> g) {
+        ++ver;
         if (! is_alias())
             igraph_destroy(ptr);
         ptr = &g.obj;
@@ -79,6 +85,8 @@ public:
     operator const igraph_t *() const { return ptr; }
 
     friend void swap(Graph &g1, Graph &g2) noexcept {
+        ++g1.ver;
+        ++g2.ver;
         igraph_t tmp = *g1.ptr;
         *g1.ptr = *g2.ptr;
         *g2.ptr = tmp;
@@ -87,11 +95,37 @@ public:
     // Necessary to allow some STL algorithms to work on GraphList,
     // whose iterator dereferences to an aliasing Graph.
     friend void swap(Graph &&g1, Graph &&g2) noexcept {
+        ++g1.ver;
+        ++g2.ver;
         igraph_t tmp = *g1.ptr;
         *g1.ptr = *g2.ptr;
         *g2.ptr = tmp;
     }
 
+    // The version of the graph, which changes whenever it is modified through this
+    // wrapper: by assignment, swap(), add_vertices(), add_edges(), delete_edges() or
+    // invalidate_cache(). Modifications made through the igraph C API should be
+    // followed by invalidate_cache(). Other wrappers aliasing the same igraph_t
+    // have their own versions. See DerivedCache.
+    std::uint64_t version() const { return ver; }
+
+    void add_vertices(igraph_integer_t n) {
+        check(igraph_add_vertices(ptr, n, nullptr));
+        ++ver;
+    }
+
+    // Adds edges given as consecutive pairs of vertex IDs.
+    void add_edges(const IntVec &edges) {
+        check(igraph_add_edges(ptr, edges, nullptr));
+        ++ver;
+    }
+
+    // Deletes edges by ID. The remaining edges are renumbered consecutively, in order.
+    void delete_edges(const IntVec &eids) {
+        check(igraph_delete_edges(ptr, igraph_ess_vector(eids)));
+        ++ver;
+    }
+
     bool is_directed() const { return igraph_is_directed(ptr); }
     igraph_integer_t vcount() const { return igraph_vcount(ptr); }
     igraph_integer_t ecount() const { return igraph_ecount(ptr); }
@@ -152,8 +186,10 @@ public:
         return res;
     }
 
+    // Clears igraph's cache of basic properties, and changes the version of the graph.
     void invalidate_cache() const {
         igraph_invalidate_cache(ptr);
+        ++ver;
     }
 
     // Note that the comparison is between labelled graphs, i.e. it does not test
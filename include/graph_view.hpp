@@ -0,0 +1,131 @@
+
+// GraphView is a lightweight, non-owning view of the adjacency structure of an igraph_t.
+// It iterates over neighbours directly on igraph's internal edge indices, without
+// allocating memory, and can therefore be used concurrently from multiple threads.
+//
+// The algorithms in igraph-cpp are written against the small interface provided by
+// GraphView: vcount(), ecount(), is_directed(), degree() and for_each_neighbor().
+// Other types implementing it can be passed to them in place of a Graph. Algorithms that
+// look up edges by ID also use from() and to(), and skip edge IDs for which the optional
+// is_deleted() returns true.
+
+namespace detail {
+
+// Calls f(args...). Returns the result of f if it is a bool, and true if f returns void.
+template<typename F, typename... Args>
+auto invoke_continue(F &f, Args... args)
+        -> typename std::enable_if<std::is_void<decltype(f(args...))>::value, bool>::type {
+    f(args...);
+    return true;
+}
+
+template<typename F, typename... Args>
+auto invoke_continue(F &f, Args... args)
+        -> typename std::enable_if<! std::is_void<decltype(f(args...))>::value, bool>::type {
+    return f(args...);
+}
+
+// Whether edge e of a view is deleted. Views without is_deleted() have no deleted edges.
+// Call as edge_deleted(g, e, 0).
+template<typename G>
+auto edge_deleted(const G &g, igraph_integer_t e, int) -> decltype(bool(g.is_deleted(e))) {
+    return g.is_deleted(e);
+}
+
+template<typename G>
+bool edge_deleted(const G &, igraph_integer_t, long) { return false; }
+
+// Whether for_each_neighbor() of views of type V reports edge IDs. Views that do not,
+// such as CompressedGraph, specialize this to false.
+template<typename V>
+struct reports_edge_ids : std::true_type { };
+
+// Throws IGRAPH_EINVAL unless 'weights' holds one value per edge of the view 'g', and
+// g reports edge IDs, so that they can index the weights.
+template<typename V>
+void check_edge_weights(const V &g, const RealVec &weights) {
+    if (! reports_edge_ids<V>::value || weights.size() != g.ecount())
+        throw Exception(IGRAPH_EINVAL);
+}
+
+// The mode that follows edges in the opposite direction.
+inline igraph_neimode_t reverse_mode(igraph_neimode_t mode) {
+    switch (mode) {
+    case IGRAPH_OUT: return IGRAPH_IN;
+    case IGRAPH_IN: return IGRAPH_OUT;
+    default: return IGRAPH_ALL;
+    }
+}
+
+inline void check_mode(igraph_neimode_t mode) {
+    if (mode != IGRAPH_OUT && mode != IGRAPH_IN && mode != IGRAPH_ALL)
+        throw Exception(IGRAPH_EINVMODE);
+}
+
+template<typename G>
+void check_vertices(const G &g, const IntVec &vids) {
+    for (auto v : vids)
+        if (v < 0 || v >= g.vcount())
+            throw Exception(IGRAPH_EINVVID);
+}
+
+} // namespace detail
+
+class GraphView {
+    const igraph_t *graph;
+
+public:
+    explicit GraphView(const igraph_t *graph_) : graph(graph_) { }
+
+    operator const igraph_t *() const { return graph; }
+
+    igraph_integer_t vcount() const { return igraph_vcount(graph); }
+    igraph_integer_t ecount() const { return igraph_ecount(graph); }
+    bool is_directed() const { return igraph_is_directed(graph); }
+
+    // Edge endpoints as stored by igraph. For undirected graphs, from(e) >= to(e).
+    igraph_integer_t from(igraph_integer_t e) const { return VECTOR(graph->from)[e]; }
+    igraph_integer_t to(igraph_integer_t e) const { return VECTOR(graph->to)[e]; }
+
+    // Number of edges incident on v in the given mode. Self-loops count twice
+    // in undirected graphs and with IGRAPH_ALL, as in igraph_degree().
+    igraph_integer_t degree(igraph_integer_t v, igraph_neimode_t mode = IGRAPH_OUT) const {
+        if (! is_directed())
+            mode = IGRAPH_ALL;
+        igraph_integer_t deg = 0;
+        if (mode & IGRAPH_OUT)
+            deg += VECTOR(graph->os)[v + 1] - VECTOR(graph->os)[v];
+        if (mode & IGRAPH_IN)
+            deg += VECTOR(graph->is)[v + 1] - VECTOR(graph->is)[v];
+        return deg;
+    }
+
+    // Calls f(u, e) for each edge e connecting v to its neighbour u in the given mode.
+    // The mode is ignored for undirected graphs. If f returns a bool, returning false
+    // stops the iteration, in which case false is returned.
+    template<typename F>
+    bool for_each_neighbor(igraph_integer_t v, igraph_neimode_t mode, F &&f) const {
+        if (! is_directed())
+            mode = IGRAPH_ALL;
+        if (mode & IGRAPH_OUT) {
+            const igraph_integer_t *oi = VECTOR(graph->oi);
+            const igraph_integer_t *to = VECTOR(graph->to);
+            for (igraph_integer_t k = VECTOR(graph->os)[v]; k < VECTOR(graph->os)[v + 1]; ++k)
+                if (! detail::invoke_continue(f, to[oi[k]], oi[k]))
+                    return false;
+        }
+        if (mode & IGRAPH_IN) {
+            const igraph_integer_t *ii = VECTOR(graph->ii);
+            const igraph_integer_t *from = VECTOR(graph->from);
+            for (igraph_integer_t k = VECTOR(graph->is)[v]; k < VECTOR(graph->is)[v + 1]; ++k)
+                if (! detail::invoke_continue(f, from[ii[k]], ii[k]))
+                    return false;
+        }
+        return true;
+    }
+};
+
+// view() returns the object algorithms operate on: a GraphView for a Graph,
+// and the object itself for types that already provide the view interface.
+inline GraphView view(const Graph &graph) { return GraphView(graph); }
+inline const GraphView &view(const GraphView &graph) { return graph; }
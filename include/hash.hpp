@@ -0,0 +1,135 @@
+
+// Hashing of vectors, matrices and graphs.
+//
+// The std::hash specializations for Vec, Mat, VecList and Graph, defined at the end of
+// igraph.hpp, allow these types to be used as keys of unordered containers, e.g. to
+// deduplicate large collections of small graphs. They are consistent with operator ==.
+//
+// Sequences are hashed in four independent lanes, which compilers can process with
+// SIMD instructions. Graphs are hashed by their labelled edge multiset: the hash of each
+// edge is summed, so that it does not depend on edge order, as igraph_is_same_graph()
+// does not. isomorphism_invariant_hash() additionally ignores vertex labels.
+
+namespace detail {
+
+constexpr std::uint64_t hash_prime1 = 0x9e3779b185ebca87;
+constexpr std::uint64_t hash_prime2 = 0xc2b2ae3d27d4eb4f;
+
+inline std::uint64_t hash_mix(std::uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+}
+
+// The 64-bit word hashed for each element. Values that compare equal give the same word.
+inline std::uint64_t hash_word(igraph_integer_t x) { return std::uint64_t(x); }
+inline std::uint64_t hash_word(bool x) { return x; }
+
+inline std::uint64_t hash_word(igraph_real_t x) {
+    // 0.0 and -0.0 compare equal.
+    if (x == 0)
+        x = 0;
+    std::uint64_t w;
+    std::memcpy(&w, &x, sizeof w);
+    return w;
+}
+
+inline std::uint64_t hash_word(const std::complex<igraph_real_t> &x) {
+    return hash_mix(hash_word(x.real())) ^ hash_word(x.imag());
+}
+
+// Hashes the elements of [begin, end) in order.
+template<typename T>
+std::uint64_t hash_range(const T *begin, const T *end) {
+    const igraph_integer_t n = end - begin;
+    std::uint64_t lanes[4] = { hash_prime1, hash_prime2, ~hash_prime1, ~hash_prime2 };
+    igraph_integer_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (int k = 0; k < 4; ++k) {
+            const std::uint64_t x = lanes[k] + hash_word(begin[i + k]) * hash_prime2;
+            lanes[k] = ((x << 31) | (x >> 33)) * hash_prime1;
+        }
+    }
+    std::uint64_t h = std::uint64_t(n);
+    for (; i < n; ++i)
+        h = hash_mix(h ^ hash_word(begin[i]));
+    for (auto lane : lanes)
+        h = hash_mix(h ^ lane);
+    return h;
+}
+
+} // namespace detail
+
+// A hash of a graph as a labelled graph, consistent with operator ==: it depends on the
+// number of vertices, the directedness, and the multiset of edges, but not on edge IDs.
+inline std::uint64_t labelled_hash(const Graph &graph) {
+    const igraph_t *g = graph;
+    const igraph_integer_t m = graph.ecount();
+    const bool directed = graph.is_directed();
+    const igraph_integer_t *from = VECTOR(g->from), *to = VECTOR(g->to);
+
+    std::uint64_t lanes[4] = { 0, 0, 0, 0 };
+    auto edge = [&](igraph_integer_t e) {
+        igraph_integer_t a = from[e], b = to[e];
+        if (! directed && a < b)
+            std::swap(a, b);
+        return detail::hash_mix(std::uint64_t(a) * detail::hash_prime1 + std::uint64_t(b));
+    };
+    igraph_integer_t e = 0;
+    for (; e + 4 <= m; e += 4)
+        for (int k = 0; k < 4; ++k)
+            lanes[k] += edge(e + k);
+    for (; e < m; ++e)
+        lanes[0] += edge(e);
+
+    std::uint64_t h = detail::hash_mix(std::uint64_t(graph.vcount()) * 2 + directed);
+    return detail::hash_mix(h ^ (lanes[0] + lanes[1] + lanes[2] + lanes[3]));
+}
+
+// A hash of a graph that does not depend on the labels of its vertices or edges, so
+// that isomorphic graphs have the same hash. It is computed by 'rounds' rounds of
+// Weisfeiler-Lehman colour refinement, starting from vertex degrees, where the colour
+// of each vertex is combined with the sum of the hashed colours of its neighbours
+// (separately for out- and in-neighbours). Non-isomorphic graphs may also collide,
+// e.g. regular graphs with the same degree, so it is meant for grouping candidates
+// before exact isomorphism tests. The graph may be a Graph or any of its views.
+template<typename G>
+std::uint64_t isomorphism_invariant_hash(const G &graph, int rounds = 3) {
+    auto &&g = view(graph);
+    const igraph_integer_t n = g.vcount();
+    const bool directed = g.is_directed();
+    const igraph_integer_t grain = 1 << 10;
+
+    std::vector<std::uint64_t> color(n), next(n);
+    detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+        for (igraph_integer_t v = begin; v < end; ++v) {
+            std::uint64_t c = g.degree(v, IGRAPH_OUT);
+            if (directed)
+                c = c * detail::hash_prime1 + g.degree(v, IGRAPH_IN);
+            color[v] = detail::hash_mix(c);
+        }
+    });
+
+    for (int round = 0; round < rounds; ++round) {
+        detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            for (igraph_integer_t v = begin; v < end; ++v) {
+                std::uint64_t out = 0, in = 0;
+                g.for_each_neighbor(v, IGRAPH_OUT, [&](igraph_integer_t u, igraph_integer_t) {
+                    out += detail::hash_mix(color[u]);
+                });
+                if (directed)
+                    g.for_each_neighbor(v, IGRAPH_IN, [&](igraph_integer_t u, igraph_integer_t) {
+                        in += detail::hash_mix(color[u] ^ detail::hash_prime2);
+                    });
+                next[v] = detail::hash_mix(color[v] * detail::hash_prime1 + out) ^ in;
+            }
+        });
+        color.swap(next);
+    }
+
+    std::uint64_t sum = 0;
+    for (auto c : color)
+        sum += detail::hash_mix(c);
+    const std::uint64_t h = detail::hash_mix(std::uint64_t(n) * 2 + directed);
+    return detail::hash_mix(h ^ sum);
+}
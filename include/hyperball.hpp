@@ -0,0 +1,167 @@
+
+// Approximate neighbourhood function with HyperLogLog counters (HyperBall).
+//
+// Each vertex v has a HyperLogLog counter estimating the size of its ball of radius t,
+// the set of vertices within distance t of v. The ball of radius t+1 is the union of
+// the balls of radius t of v and of its neighbours, and the union of two counters is
+// their register-wise maximum. All counters are stored in one flat buffer of bytes,
+// with 2^log2m >= 16 registers per vertex, so that each merge is a branch-free loop
+// over whole vectors of registers, which compilers turn into SIMD max instructions.
+//
+// A counter can only change if the counter of one of its neighbours changed in the
+// previous round, so only those neighbours are merged, and vertices without changed
+// neighbours are skipped. The relative standard error of each estimate is about
+// 1.04 / sqrt(2^log2m).
+
+namespace detail {
+
+class HyperLogLog {
+    int log2m;
+    igraph_integer_t m;
+    igraph_real_t alpha_mm;
+    igraph_real_t inv_pow2[66];
+    std::uint64_t salt;
+
+public:
+    HyperLogLog(int log2m, std::uint64_t salt) : log2m(log2m), m(igraph_integer_t(1) << log2m), salt(salt) {
+        const igraph_real_t alpha = 0.7213 / (1 + 1.079 / m);
+        alpha_mm = alpha * m * m;
+        for (int r = 0; r < 66; ++r)
+            inv_pow2[r] = std::ldexp(1.0, -r);
+    }
+
+    igraph_integer_t registers() const { return m; }
+
+    // Adds item x to the counter 'reg'.
+    void add(std::uint8_t *reg, igraph_integer_t x) const {
+        std::uint64_t h = std::uint64_t(x) ^ salt;
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111eb;
+        h ^= h >> 31;
+        const std::uint64_t index = h >> (64 - log2m);
+        // The sentinel bit limits the rank to 64 - log2m + 1.
+        const std::uint64_t rest = (h << log2m) | (std::uint64_t(1) << (log2m - 1));
+        const std::uint8_t rank = count_leading_zeros(rest) + 1;
+        reg[index] = std::max(reg[index], rank);
+    }
+
+    // Merges 'src' into 'dst', and returns whether 'dst' changed.
+    bool merge(std::uint8_t *dst, const std::uint8_t *src) const {
+        std::uint8_t changed = 0;
+        for (igraph_integer_t i = 0; i < m; ++i) {
+            const std::uint8_t r = std::max(dst[i], src[i]);
+            changed |= r ^ dst[i];
+            dst[i] = r;
+        }
+        return changed;
+    }
+
+    igraph_real_t estimate(const std::uint8_t *reg) const {
+        igraph_real_t sum = 0;
+        igraph_integer_t zeros = 0;
+        for (igraph_integer_t i = 0; i < m; ++i) {
+            sum += inv_pow2[reg[i]];
+            zeros += reg[i] == 0;
+        }
+        const igraph_real_t e = alpha_mm / sum;
+        // Linear counting is more accurate for small cardinalities.
+        if (e <= 2.5 * m && zeros > 0)
+            return m * std::log(igraph_real_t(m) / zeros);
+        return e;
+    }
+};
+
+} // namespace detail
+
+struct HyperBallResult {
+    // pairs[t] is the estimated number of ordered pairs (v, u) with d(v, u) <= t.
+    RealVec pairs;
+    // The estimated number of vertices reachable from each vertex, including itself.
+    RealVec reachable;
+    // The estimated harmonic centrality of each vertex: the sum of 1 / d(v, u) over the
+    // vertices u != v reachable from v.
+    RealVec harmonic;
+};
+
+// Estimates the neighbourhood function of a graph with HyperBall, using multiple
+// threads. Each vertex uses 2^log2m bytes, twice; 'log2m' must be between 4 and 16.
+// Distances are measured along the direction of edges (IGRAPH_OUT), against it
+// (IGRAPH_IN), or ignoring directions (IGRAPH_ALL). If 'max_distance' is non-negative,
+// only distances up to it are considered. The estimates depend on the state of
+// igraph's random number generator, which is used to choose a hash function.
+template<typename G>
+HyperBallResult hyperball(const G &graph, int log2m = 7, igraph_neimode_t mode = IGRAPH_OUT,
+                          igraph_integer_t max_distance = -1) {
+    auto &&g = view(graph);
+    detail::check_mode(mode);
+    if (log2m < 4 || log2m > 16)
+        throw Exception(IGRAPH_EINVAL);
+
+    const igraph_integer_t n = g.vcount();
+    const igraph_integer_t grain = 256;
+    const detail::HyperLogLog hll(log2m, RNGStream::seed_from_igraph());
+    const igraph_integer_t m = hll.registers();
+
+    std::vector<std::uint8_t> current(n * m), next(n * m);
+    std::vector<char> changed(n, true), next_changed(n);
+
+    HyperBallResult res;
+    res.reachable.resize(n);
+    res.harmonic.resize(n);
+    detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+        for (igraph_integer_t v = begin; v < end; ++v) {
+            hll.add(&current[v * m], v);
+            res.reachable[v] = hll.estimate(&current[v * m]);
+            res.harmonic[v] = 0;
+        }
+    });
+    res.pairs.push_back(std::accumulate(res.reachable.begin(), res.reachable.end(), igraph_real_t(0)));
+
+    for (igraph_integer_t t = 1; max_distance < 0 || t <= max_distance; ++t) {
+        const igraph_integer_t count = detail::parallel_sum<igraph_integer_t>(n, grain, [&](igraph_integer_t begin, igraph_integer_t end) {
+            igraph_integer_t count = 0;
+            for (igraph_integer_t v = begin; v < end; ++v) {
+                std::uint8_t *dst = &next[v * m];
+                std::copy(&current[v * m], &current[v * m] + m, dst);
+                bool updated = false;
+                g.for_each_neighbor(v, mode, [&](igraph_integer_t u, igraph_integer_t) {
+                    if (changed[u])
+                        updated |= hll.merge(dst, &current[u * m]);
+                });
+                next_changed[v] = updated;
+                if (updated) {
+                    // The vertices added to the ball are at distance t.
+                    const igraph_real_t size = hll.estimate(dst);
+                    res.harmonic[v] += (size - res.reachable[v]) / t;
+                    res.reachable[v] = size;
+                    ++count;
+                }
+            }
+            return count;
+        });
+        if (count == 0)
+            break;
+        current.swap(next);
+        changed.swap(next_changed);
+        res.pairs.push_back(std::accumulate(res.reachable.begin(), res.reachable.end(), igraph_real_t(0)));
+    }
+
+    return res;
+}
+
+// The effective diameter from a neighbourhood function, such as the 'pairs' returned
+// by hyperball(): the smallest distance within which the given fraction of all
+// connected pairs lie, interpolated linearly between integer distances.
+inline igraph_real_t effective_diameter(const RealVec &pairs, igraph_real_t fraction = 0.9) {
+    if (pairs.size() == 0 || ! (fraction > 0 && fraction <= 1))
+        throw Exception(IGRAPH_EINVAL);
+    const igraph_real_t target = fraction * pairs[pairs.size() - 1];
+    for (igraph_integer_t t = 0; t < pairs.size(); ++t) {
+        if (pairs[t] >= target) {
+            if (t == 0)
+                return 0;
+            return t - 1 + (target - pairs[t - 1]) / (pairs[t] - pairs[t - 1]);
+        }
+    }
+    return pairs.size() - 1;
+}
@@ -8,13 +8,43 @@
 #error "This version of igraph-cpp requires igraph 0.10."
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
 #include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <condition_variable>
+#include <exception>
+#include <functional>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
 #include <random>
 #include <stdexcept>
+#include <string>
+#include <thread>
 #include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
 #include <utility>
+#include <vector>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace ig {
 
@@ -149,6 +179,70 @@ using ComplexMat = Mat<std::complex<igraph_real_t>>;
 
 #include "rng_scope.hpp"
 
+#include "parallel.hpp"
+#include "graph_view.hpp"
+#include "filtered_view.hpp"
+#include "view_adaptors.hpp"
+#include "csr_graph.hpp"
+#include "compressed_graph.hpp"
+#include "edge_index.hpp"
+#include "sparsemat.hpp"
+
+#include "components.hpp"
+#include "connectivity_tracker.hpp"
+#include "dynamic_graph.hpp"
+#include "ms_bfs.hpp"
+#include "bfs.hpp"
+#include "delta_stepping.hpp"
+#include "floyd_warshall.hpp"
+#include "power_iteration.hpp"
+#include "incremental_pagerank.hpp"
+#include "coreness.hpp"
+#include "label_propagation.hpp"
+#include "alias_table.hpp"
+#include "random_walks.hpp"
+#include "hyperball.hpp"
+#include "reorder.hpp"
+#include "sharded_graph.hpp"
+#include "derived_cache.hpp"
+#include "hash.hpp"
+
 } // namespace ig
 
+namespace std {
+
+template<typename T>
+struct hash<ig::Vec<T>> {
+    std::size_t operator () (const ig::Vec<T> &vec) const {
+        return ig::detail::hash_range(vec.begin(), vec.end());
+    }
+};
+
+// Consistent with operator ==, which compares the elements, but not the dimensions.
+template<typename T>
+struct hash<ig::Mat<T>> {
+    std::size_t operator () (const ig::Mat<T> &mat) const {
+        return ig::detail::hash_range(mat.begin(), mat.end());
+    }
+};
+
+template<typename T>
+struct hash<ig::VecList<T>> {
+    std::size_t operator () (const ig::VecList<T> &list) const {
+        std::uint64_t h = list.size();
+        for (igraph_integer_t i = 0; i < list.size(); ++i)
+            h = ig::detail::hash_mix(h ^ hash<ig::Vec<T>>()(list[i]));
+        return h;
+    }
+};
+
+template<>
+struct hash<ig::Graph> {
+    std::size_t operator () (const ig::Graph &graph) const {
+        return ig::labelled_hash(graph);
+    }
+};
+
+} // namespace std
+
 #endif // IGCPP_IGRAPH_HPP
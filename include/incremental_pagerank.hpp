@@ -0,0 +1,127 @@
+
+// Incremental PageRank maintenance under edge insertions and deletions.
+//
+// If 'rank' is the PageRank vector of a graph, changing a few edges only perturbs the
+// fixed-point equation at the vertices whose in-neighbourhood changed. The perturbation
+// is computed locally, from the edges of the vertices that gained or lost out-edges, and
+// becomes the initial residual of a forward-push solver. Each push moves the residual
+// of a vertex into its score and spreads the damped remainder over its out-neighbours,
+// so that only the region around the changes is visited.
+//
+// Residual mass reaching vertices without out-edges is teleported according to the reset
+// distribution. Its effect on the solution is therefore proportional to the PageRank
+// vector itself, and is accounted for by normalizing the scores at the end, instead of
+// being spread over all vertices.
+
+// Applies a batch of edge changes to 'graph' and updates 'rank', its previous PageRank
+// vector, accordingly. 'remove' and 'insert' list the endpoints of edges, in the same
+// format as igraph_add_edges(); edges are removed first. Each pair in 'remove' must
+// match a distinct existing edge.
+//
+// The update is exact up to the residual left at each vertex, which is below
+// 'tolerance'. The damping factor must be the one 'rank' was computed with. Personalized
+// PageRank vectors can be updated as well, as long as random walkers at vertices without
+// out-edges jumped according to the same reset distribution. Edges are treated as
+// unweighted. Returns the number of push operations.
+inline igraph_integer_t pagerank_update(Graph &graph, RealVec &rank,
+                                        const IntVec &insert, const IntVec &remove,
+                                        igraph_real_t damping = 0.85, igraph_real_t tolerance = 1e-10) {
+    if (rank.size() != graph.vcount())
+        throw Exception(IGRAPH_EINVAL);
+    if (! (damping >= 0 && damping < 1) || ! (tolerance > 0))
+        throw Exception(IGRAPH_EINVAL);
+    if (insert.size() % 2 != 0 || remove.size() % 2 != 0)
+        throw Exception(IGRAPH_EINVAL);
+    // Validate all input before modifying the graph, so that it is left unchanged on error.
+    for (auto v : insert)
+        if (v < 0 || v >= graph.vcount())
+            throw Exception(IGRAPH_EINVVID);
+
+    if (! remove.empty()) {
+        IntVec eids;
+        check(igraph_get_eids(graph, eids, remove, true, true));
+        graph.delete_edges(eids);
+    }
+    if (! insert.empty())
+        graph.add_edges(insert);
+
+    const GraphView g(graph);
+    const bool directed = g.is_directed();
+
+    // The vertices whose out-edges changed, with the inserted and removed heads.
+    struct Change {
+        std::vector<igraph_integer_t> inserted, removed;
+    };
+    std::unordered_map<igraph_integer_t, Change> changes;
+    auto record = [&](const IntVec &edges, std::vector<igraph_integer_t> Change::*list) {
+        for (igraph_integer_t i = 0; i < edges.size(); i += 2) {
+            (changes[edges[i]].*list).push_back(edges[i + 1]);
+            if (! directed)
+                (changes[edges[i + 1]].*list).push_back(edges[i]);
+        }
+    };
+    record(insert, &Change::inserted);
+    record(remove, &Change::removed);
+
+    std::unordered_map<igraph_integer_t, igraph_real_t> residual;
+
+    // Each vertex u sends damping * rank[u] / outdeg(u) to each of its out-neighbours.
+    // The initial residual is the difference between what is sent after and before the
+    // change. Teleportation is handled by the final normalization.
+    for (const auto &c : changes) {
+        const igraph_integer_t u = c.first;
+        const igraph_integer_t new_degree = g.degree(u, IGRAPH_OUT);
+        const igraph_integer_t old_degree = new_degree
+                - igraph_integer_t(c.second.inserted.size()) + igraph_integer_t(c.second.removed.size());
+        const igraph_real_t mass = damping * rank[u];
+
+        const igraph_real_t old_share = old_degree > 0 ? mass / old_degree : 0;
+        const igraph_real_t new_share = new_degree > 0 ? mass / new_degree : 0;
+
+        g.for_each_neighbor(u, IGRAPH_OUT, [&](igraph_integer_t w, igraph_integer_t) {
+            residual[w] += new_share - old_share;
+        });
+        for (auto w : c.second.inserted)
+            residual[w] += old_share;
+        for (auto w : c.second.removed)
+            residual[w] -= old_share;
+    }
+
+    std::deque<igraph_integer_t> queue;
+    for (const auto &r : residual)
+        if (std::abs(r.second) > tolerance)
+            queue.push_back(r.first);
+
+    igraph_integer_t pushes = 0;
+    while (! queue.empty()) {
+        const igraph_integer_t u = queue.front();
+        queue.pop_front();
+
+        igraph_real_t &ru = residual[u];
+        const igraph_real_t r = ru;
+        if (std::abs(r) <= tolerance)
+            continue;
+        ru = 0;
+        rank[u] += r;
+        ++pushes;
+
+        const igraph_integer_t degree = g.degree(u, IGRAPH_OUT);
+        if (degree == 0)
+            continue;
+        const igraph_real_t share = damping * r / degree;
+        g.for_each_neighbor(u, IGRAPH_OUT, [&](igraph_integer_t w, igraph_integer_t) {
+            igraph_real_t &rw = residual[w];
+            const bool queued = std::abs(rw) > tolerance;
+            rw += share;
+            if (! queued && std::abs(rw) > tolerance)
+                queue.push_back(w);
+        });
+    }
+
+    const igraph_real_t sum = std::accumulate(rank.begin(), rank.end(), igraph_real_t(0));
+    if (sum > 0)
+        for (auto &x : rank)
+            x /= sum;
+
+    return pushes;
+}
@@ -0,0 +1,207 @@
+
+// Parallel community detection by label propagation.
+//
+// Each vertex starts with its own label and repeatedly adopts the label that is most
+// frequent (or has the largest total weight) among its neighbours, until every vertex
+// has one of the dominant labels of its neighbourhood. Labels are counted in a small
+// per-thread hash table with open addressing, which is reused between vertices.
+//
+// By default, threads update labels asynchronously, in place, as in the sequential
+// algorithm; the result then depends on thread scheduling. In deterministic mode,
+// each sweep over the vertices, in random order, is divided into a fixed number of
+// batches. Vertices within a batch are updated from the labels of the previous
+// batches, and random choices are drawn from a generator specific to the vertex and
+// the sweep. The result then only depends on the state of igraph's random number
+// generator, and not on the number of threads.
+
+namespace detail {
+
+constexpr igraph_integer_t label_propagation_batches = 32;
+constexpr igraph_integer_t label_propagation_max_sweeps = 1000;
+
+// Accumulates the weight of each label among the neighbours of a vertex.
+class LabelHistogram {
+    std::vector<igraph_integer_t> keys;     // -1 for empty slots
+    std::vector<igraph_real_t> weights;
+    std::vector<std::size_t> used;          // occupied slots, in insertion order
+    int shift = 64;                         // 64 - log2(capacity)
+
+public:
+    // Empties the table, and makes room for 'count' labels.
+    void reset(igraph_integer_t count) {
+        for (auto slot : used)
+            keys[slot] = -1;
+        used.clear();
+
+        std::size_t capacity = 16;
+        while (capacity < std::size_t(2 * count))
+            capacity *= 2;
+        if (capacity > keys.size()) {
+            keys.assign(capacity, -1);
+            weights.resize(capacity);
+            shift = 64;
+            for (std::size_t c = capacity; c > 1; c /= 2)
+                --shift;
+        }
+    }
+
+    void add(igraph_integer_t label, igraph_real_t weight) {
+        const std::size_t mask = keys.size() - 1;
+        // Fibonacci hashing: the top bits of the product, as many as the table needs.
+        std::size_t slot = (std::uint64_t(label) * 0x9e3779b97f4a7c15) >> shift;
+        while (keys[slot] != label) {
+            if (keys[slot] < 0) {
+                keys[slot] = label;
+                weights[slot] = 0;
+                used.push_back(slot);
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+        weights[slot] += weight;
+    }
+
+    // Returns 'current' if it is one of the labels with the largest weight, and one of
+    // those labels, chosen uniformly at random, otherwise.
+    template<typename RNG>
+    igraph_integer_t dominant(igraph_integer_t current, RNG &rng) const {
+        igraph_real_t best = -1, current_weight = -1;
+        igraph_integer_t choice = current, ties = 0;
+        for (auto slot : used) {
+            const igraph_real_t w = weights[slot];
+            if (keys[slot] == current)
+                current_weight = w;
+            if (w > best) {
+                best = w;
+                choice = keys[slot];
+                ties = 1;
+            } else if (w == best && rng.integer(++ties) == 0) {
+                choice = keys[slot];
+            }
+        }
+        return current_weight == best ? current : choice;
+    }
+};
+
+} // namespace detail
+
+// Detects communities by label propagation using multiple threads, and returns the
+// community index of each vertex. Communities are numbered in the order of their
+// smallest vertex. If 'weights' is given, labels are weighted by the (non-negative)
+// weights of the edges they are received through. With IGRAPH_OUT, labels propagate
+// along the direction of edges, with IGRAPH_IN against it, and with IGRAPH_ALL both ways.
+// If 'deterministic' is true, the result only depends on the state of igraph's random
+// number generator (see RNGScope), not on thread scheduling; otherwise it varies
+// between runs.
+template<typename G>
+IntVec label_propagation(const G &graph, const RealVec *weights = nullptr,
+                         igraph_neimode_t mode = IGRAPH_ALL, bool deterministic = false) {
+    auto &&g = view(graph);
+    detail::check_mode(mode);
+    if (weights) {
+        detail::check_edge_weights(g, *weights);
+        for (auto w : *weights)
+            if (! (w >= 0))
+                throw Exception(IGRAPH_EINVAL);
+    }
+
+    const igraph_integer_t n = g.vcount();
+    const igraph_integer_t grain = 1 << 10;
+    const igraph_neimode_t pull_mode = detail::reverse_mode(mode);
+    const std::uint64_t seed = RNGStream::seed_from_igraph();
+
+    std::vector<std::atomic<igraph_integer_t>> labels(n);
+    for (igraph_integer_t v = 0; v < n; ++v)
+        labels[v].store(v, std::memory_order_relaxed);
+
+    // Vertices are visited in a new random order in each sweep. In deterministic mode,
+    // this also prevents neighbours from being updated in the same batch in every sweep,
+    // where they could keep exchanging their labels.
+    std::vector<igraph_integer_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    RNGStream shuffle_rng(seed);
+    auto shuffle = [&]() {
+        for (igraph_integer_t i = n - 1; i > 0; --i)
+            std::swap(order[i], order[shuffle_rng.integer(i + 1)]);
+    };
+
+    std::vector<detail::LabelHistogram> histograms(thread_count());
+
+    auto dominant_label = [&](igraph_integer_t v, detail::LabelHistogram &hist, RNGStream &rng) {
+        hist.reset(g.degree(v, pull_mode));
+        g.for_each_neighbor(v, pull_mode, [&](igraph_integer_t u, igraph_integer_t e) {
+            hist.add(labels[u].load(std::memory_order_relaxed), weights ? (*weights)[e] : 1);
+        });
+        return hist.dominant(labels[v].load(std::memory_order_relaxed), rng);
+    };
+
+    if (deterministic) {
+        const igraph_integer_t batch_size = std::max<igraph_integer_t>(
+                    1, (n + detail::label_propagation_batches - 1) / detail::label_propagation_batches);
+        std::vector<igraph_integer_t> next(batch_size);
+
+        for (igraph_integer_t sweep = 0; sweep < detail::label_propagation_max_sweeps; ++sweep) {
+            std::atomic<igraph_integer_t> changes{0};
+            shuffle();
+            for (igraph_integer_t lo = 0; lo < n; lo += batch_size) {
+                const igraph_integer_t hi = std::min(lo + batch_size, n);
+                detail::parallel_for(hi - lo, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned tid) {
+                    for (igraph_integer_t i = begin; i < end; ++i) {
+                        const igraph_integer_t v = order[lo + i];
+                        RNGStream rng(seed + sweep + 1, v);
+                        next[i] = dominant_label(v, histograms[tid], rng);
+                    }
+                });
+                detail::parallel_for(hi - lo, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+                    igraph_integer_t count = 0;
+                    for (igraph_integer_t i = begin; i < end; ++i) {
+                        const igraph_integer_t v = order[lo + i];
+                        if (labels[v].load(std::memory_order_relaxed) != next[i]) {
+                            labels[v].store(next[i], std::memory_order_relaxed);
+                            ++count;
+                        }
+                    }
+                    changes.fetch_add(count, std::memory_order_relaxed);
+                });
+            }
+            if (changes.load() == 0)
+                break;
+        }
+    } else {
+        std::vector<RNGStream> rngs;
+        for (std::size_t t = 0; t < histograms.size(); ++t)
+            rngs.emplace_back(seed, t + 1);
+
+        for (igraph_integer_t sweep = 0; sweep < detail::label_propagation_max_sweeps; ++sweep) {
+            std::atomic<igraph_integer_t> changes{0};
+            shuffle();
+            detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned tid) {
+                igraph_integer_t count = 0;
+                for (igraph_integer_t i = begin; i < end; ++i) {
+                    const igraph_integer_t v = order[i];
+                    const igraph_integer_t label = dominant_label(v, histograms[tid], rngs[tid]);
+                    if (label != labels[v].load(std::memory_order_relaxed)) {
+                        labels[v].store(label, std::memory_order_relaxed);
+                        ++count;
+                    }
+                }
+                changes.fetch_add(count, std::memory_order_relaxed);
+            });
+            if (changes.load() == 0)
+                break;
+        }
+    }
+
+    // Number the communities in the order of their smallest vertex.
+    IntVec membership(n);
+    std::vector<igraph_integer_t> index(n, -1);
+    igraph_integer_t count = 0;
+    for (igraph_integer_t v = 0; v < n; ++v) {
+        const igraph_integer_t label = labels[v].load(std::memory_order_relaxed);
+        if (index[label] < 0)
+            index[label] = count++;
+        membership[v] = index[label];
+    }
+
+    return membership;
+}
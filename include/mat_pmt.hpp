@@ -134,13 +134,8 @@ public:
     friend bool operator == (const Mat &lhs, const Mat &rhs) {
         if (lhs.ptr == rhs.ptr)
             return true;
-        size_type n = lhs.size();
-        if (rhs.size() != n)
-            return false;
-        for (size_type i = 0; i < n; ++i)
-            if (lhs[i] != rhs[i])
-                return false;
-        return true;
+        // std::equal() compares integer elements with memcmp().
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
 
     friend bool operator != (const Mat &lhs, const Mat &rhs) {
@@ -0,0 +1,158 @@
+
+// Bit-parallel multi-source breadth-first search (MS-BFS).
+//
+// Up to 256 breadth-first searches are run simultaneously. Each vertex keeps one bit
+// per search in a few 64-bit words, recording which searches have already reached it
+// and which ones reached it in the last step. A single pass over the adjacency
+// structure then advances all searches by one step, so that sources that are close
+// to each other share most of the work. The word-wise operations on 256 bits are
+// written to be vectorized by the compiler.
+//
+// Each step is pulled: a vertex collects the search bits of its neighbours on the
+// reverse edges, which allows the vertices to be processed in parallel without
+// synchronization. Vertices that have already been reached by all searches of the
+// batch are skipped.
+
+namespace detail {
+
+constexpr igraph_integer_t ms_bfs_batch_size = 256;
+
+// Runs BFS from sources[0], ..., sources[count-1] simultaneously, with count <= 64*W,
+// and calls record(i, v, d) when search i reaches v at distance d. record() is called
+// concurrently, but never concurrently for the same vertex.
+template<int W, typename G, typename R>
+void ms_bfs_batch(const G &g, const igraph_integer_t *sources, igraph_integer_t count,
+                  igraph_neimode_t mode, R &record) {
+    using word = std::uint64_t;
+    const igraph_integer_t n = g.vcount();
+    const igraph_neimode_t pull_mode = reverse_mode(mode);
+
+    std::vector<word> seen(n * W, 0), visit(n * W, 0), next(n * W, 0);
+
+    word full[W] = { };
+    for (igraph_integer_t i = 0; i < count; ++i) {
+        const word bit = word(1) << (i % 64);
+        const igraph_integer_t v = sources[i];
+        full[i / 64] |= bit;
+        seen[v * W + i / 64] |= bit;
+        visit[v * W + i / 64] |= bit;
+        record(i, v, 0);
+    }
+
+    for (igraph_integer_t level = 1; ; ++level) {
+        std::atomic<bool> active{false};
+
+        parallel_for(n, 1024, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            bool found = false;
+            for (igraph_integer_t u = begin; u < end; ++u) {
+                word *su = &seen[u * W];
+                word acc[W] = { };
+
+                bool complete = true;
+                for (int w = 0; w < W; ++w)
+                    complete &= su[w] == full[w];
+
+                if (! complete) {
+                    g.for_each_neighbor(u, pull_mode, [&](igraph_integer_t v, igraph_integer_t) {
+                        const word *vv = &visit[v * W];
+                        for (int w = 0; w < W; ++w)
+                            acc[w] |= vv[w];
+                    });
+                }
+
+                word any = 0;
+                for (int w = 0; w < W; ++w) {
+                    acc[w] &= ~su[w];
+                    next[u * W + w] = acc[w];
+                    any |= acc[w];
+                }
+                if (! any)
+                    continue;
+
+                found = true;
+                for (int w = 0; w < W; ++w) {
+                    su[w] |= acc[w];
+                    for (word bits = acc[w]; bits; bits &= bits - 1)
+                        record(w * 64 + count_trailing_zeros(bits), u, level);
+                }
+            }
+            if (found)
+                active.store(true, std::memory_order_relaxed);
+        });
+
+        if (! active.load())
+            break;
+        visit.swap(next);
+    }
+}
+
+template<typename G, typename R>
+void ms_bfs(const G &g, const igraph_integer_t *sources, igraph_integer_t count,
+            igraph_neimode_t mode, R &&record) {
+    if (count <= 64)
+        ms_bfs_batch<1>(g, sources, count, mode, record);
+    else if (count <= 128)
+        ms_bfs_batch<2>(g, sources, count, mode, record);
+    else
+        ms_bfs_batch<4>(g, sources, count, mode, record);
+}
+
+} // namespace detail
+
+// Computes hop distances from each of the given sources to all vertices, running many
+// breadth-first searches simultaneously. Row i of 'res' will contain the distances from
+// sources[i]; unreachable vertices are marked with -1. The mode determines whether
+// edges are followed in their own direction (IGRAPH_OUT), in reverse (IGRAPH_IN)
+// or both ways (IGRAPH_ALL); it is ignored for undirected graphs.
+template<typename G>
+void multi_source_distances(const G &graph, const IntVec &sources, IntMat &res,
+                            igraph_neimode_t mode = IGRAPH_OUT) {
+    auto &&g = view(graph);
+    detail::check_mode(mode);
+    detail::check_vertices(g, sources);
+
+    const igraph_integer_t k = sources.size();
+    res.resize(k, g.vcount());
+    std::fill(res.begin(), res.end(), -1);
+
+    for (igraph_integer_t start = 0; start < k; start += detail::ms_bfs_batch_size) {
+        const igraph_integer_t count = std::min(k - start, detail::ms_bfs_batch_size);
+        detail::ms_bfs(g, sources.begin() + start, count, mode,
+                       [&](igraph_integer_t i, igraph_integer_t v, igraph_integer_t d) {
+            res(start + i, v) = d;
+        });
+    }
+}
+
+// Like multi_source_distances(), but instead of storing the full distance matrix, calls
+// f(i, dist) with the distances from sources[i] as soon as they are available, so that
+// only a few hundred rows are held in memory at a time. 'dist' is an IntVec that is only
+// valid during the call. f is called on the calling thread, in the order of the sources.
+template<typename G, typename F>
+void multi_source_bfs(const G &graph, const IntVec &sources, F f,
+                      igraph_neimode_t mode = IGRAPH_OUT) {
+    auto &&g = view(graph);
+    detail::check_mode(mode);
+    detail::check_vertices(g, sources);
+
+    const igraph_integer_t n = g.vcount();
+    const igraph_integer_t k = sources.size();
+    IntMat batch;
+    IntVec row(n);
+    const IntVec &dist = row;
+
+    for (igraph_integer_t start = 0; start < k; start += detail::ms_bfs_batch_size) {
+        const igraph_integer_t count = std::min(k - start, detail::ms_bfs_batch_size);
+        batch.resize(count, n);
+        std::fill(batch.begin(), batch.end(), -1);
+        detail::ms_bfs(g, sources.begin() + start, count, mode,
+                       [&](igraph_integer_t i, igraph_integer_t v, igraph_integer_t d) {
+            batch(i, v) = d;
+        });
+        for (igraph_integer_t i = 0; i < count; ++i) {
+            for (igraph_integer_t v = 0; v < n; ++v)
+                row[v] = batch(i, v);
+            f(start + i, dist);
+        }
+    }
+}
@@ -0,0 +1,304 @@
+
+// Multi-threading support.
+//
+// igraph-cpp uses a single, lazily started pool of worker threads for all of its
+// parallel routines. The number of threads can be set with set_thread_count();
+// by default it is std::thread::hardware_concurrency().
+//
+// Parallel regions do not nest: a parallel routine invoked from within a parallel
+// region (or while another thread is using the pool) runs on the calling thread.
+// set_thread_count() must not be called while a parallel routine is running.
+
+namespace detail {
+
+inline unsigned &thread_count_setting() {
+    static unsigned count = 0;
+    return count;
+}
+
+inline bool &in_parallel_region() {
+    thread_local bool flag = false;
+    return flag;
+}
+
+class ThreadPool {
+    using job_type = std::function<void(unsigned)>;
+
+    std::vector<std::thread> workers;
+    std::mutex run_mutex;   // held for the duration of a parallel region
+    std::mutex mutex;       // protects the fields below
+    std::condition_variable wake, done;
+    const job_type *job = nullptr;
+    unsigned participants = 0;
+    unsigned pending = 0;
+    unsigned long generation = 0;
+    bool stopping = false;
+    std::exception_ptr error;
+
+    ThreadPool() = default;
+
+    void record_error() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (! error)
+            error = std::current_exception();
+    }
+
+    void worker(unsigned index, unsigned long seen) {
+        in_parallel_region() = true;
+        for (;;) {
+            const job_type *current;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping)
+                    return;
+                seen = generation;
+                if (index >= participants)
+                    continue;
+                current = job;
+            }
+            try {
+                (*current)(index + 1);
+            } catch (...) {
+                record_error();
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0)
+                done.notify_one();
+        }
+    }
+
+    static void run_serial(unsigned nthreads, const job_type &f) {
+        for (unsigned tid = 0; tid < nthreads; ++tid)
+            f(tid);
+    }
+
+public:
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool & operator = (const ThreadPool &) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &t : workers)
+            t.join();
+    }
+
+    static ThreadPool &instance() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    // Calls f(tid) for each tid in [0, nthreads), concurrently when possible.
+    // The calling thread runs tid 0. The first exception thrown by any of the
+    // calls is rethrown once all of them have finished.
+    void run(unsigned nthreads, const job_type &f) {
+        if (nthreads <= 1 || in_parallel_region()) {
+            run_serial(nthreads, f);
+            return;
+        }
+
+        std::unique_lock<std::mutex> busy(run_mutex, std::try_to_lock);
+        if (! busy.owns_lock()) {
+            run_serial(nthreads, f);
+            return;
+        }
+
+        while (workers.size() < nthreads - 1) {
+            unsigned index = workers.size();
+            unsigned long current = generation;
+            workers.emplace_back([this, index, current] { worker(index, current); });
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &f;
+            participants = nthreads - 1;
+            pending = nthreads - 1;
+            error = nullptr;
+            ++generation;
+        }
+        wake.notify_all();
+
+        in_parallel_region() = true;
+        try {
+            f(0);
+        } catch (...) {
+            record_error();
+        }
+        in_parallel_region() = false;
+
+        std::exception_ptr err;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [&] { return pending == 0; });
+            job = nullptr;
+            err = error;
+            error = nullptr;
+        }
+        if (err)
+            std::rethrow_exception(err);
+    }
+};
+
+} // namespace detail
+
+// The number of threads used by parallel routines.
+inline unsigned thread_count() {
+    unsigned count = detail::thread_count_setting();
+    if (count == 0)
+        count = std::thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+// Sets the number of threads used by parallel routines. Zero restores the default.
+inline void set_thread_count(unsigned count) {
+    detail::thread_count_setting() = count;
+}
+
+namespace detail {
+
+// Runs f(tid) on thread_count() threads, see ThreadPool::run().
+template<typename F>
+void parallel_threads(F &&f) {
+    ThreadPool::instance().run(thread_count(), std::function<void(unsigned)>(std::forward<F>(f)));
+}
+
+// Calls f(begin, end, tid) for each chunk [k*grain, min((k+1)*grain, n)) of [0, n).
+// Chunks are distributed dynamically among the threads.
+template<typename F>
+void parallel_for(igraph_integer_t n, igraph_integer_t grain, F &&f) {
+    if (n <= 0)
+        return;
+    if (grain < 1)
+        grain = 1;
+
+    igraph_integer_t nchunks = (n + grain - 1) / grain;
+    if (nchunks == 1) {
+        f(igraph_integer_t(0), n, 0u);
+        return;
+    }
+
+    std::atomic<igraph_integer_t> next{0};
+    unsigned nthreads = std::min<igraph_integer_t>(thread_count(), nchunks);
+    ThreadPool::instance().run(nthreads, [&](unsigned tid) {
+        for (;;) {
+            igraph_integer_t chunk = next.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= nchunks)
+                break;
+            igraph_integer_t begin = chunk * grain;
+            f(begin, std::min(begin + grain, n), tid);
+        }
+    });
+}
+
+// Returns the sum of f(begin, end) over the chunks of [0, n), see parallel_for().
+template<typename T, typename F>
+T parallel_sum(igraph_integer_t n, igraph_integer_t grain, F &&f) {
+    std::vector<T> partial(thread_count(), T());
+    parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned tid) {
+        partial[tid] += f(begin, end);
+    });
+    return std::accumulate(partial.begin(), partial.end(), T());
+}
+
+// Maps the return type of a per-graph function to the container that collects its results.
+template<typename R, typename Enable = void>
+struct transform_result;
+
+template<typename R>
+struct transform_result<R, typename std::enable_if<std::is_same<R, bool>::value>::type> {
+    using type = BoolVec;
+    static void store(type &res, igraph_integer_t i, R val) { res[i] = val; }
+};
+
+template<typename R>
+struct transform_result<R, typename std::enable_if<std::is_integral<R>::value && ! std::is_same<R, bool>::value>::type> {
+    using type = IntVec;
+    static void store(type &res, igraph_integer_t i, R val) { res[i] = val; }
+};
+
+template<typename R>
+struct transform_result<R, typename std::enable_if<std::is_floating_point<R>::value>::type> {
+    using type = RealVec;
+    static void store(type &res, igraph_integer_t i, R val) { res[i] = val; }
+};
+
+template<typename T>
+struct transform_result<Vec<T>> {
+    using type = VecList<T>;
+    static void store(type &res, igraph_integer_t i, Vec<T> val) { swap(res[i], std::move(val)); }
+};
+
+} // namespace detail
+
+// Applies f to each graph in 'list' in parallel, and returns the results in the same order.
+// Scalar results are collected into a Vec, and Vec results into a VecList.
+//
+// Graphs are scheduled from largest to smallest (by vertex plus edge count), with small
+// graphs batched together, so that a few very large graphs among many small ones do not
+// leave threads idle at the end. 'f' must be safe to call concurrently. If it calls igraph
+// functions, igraph must have been built with thread-local storage; otherwise the graphs
+// are processed on the calling thread only.
+template<typename F>
+auto parallel_transform(const GraphList &list, F f)
+        -> typename detail::transform_result<typename std::decay<decltype(f(std::declval<const Graph &>()))>::type>::type {
+    using R = typename std::decay<decltype(f(std::declval<const Graph &>()))>::type;
+    using result = detail::transform_result<R>;
+
+    const igraph_integer_t n = list.size();
+    typename result::type res(n);
+    if (n == 0)
+        return res;
+
+    std::vector<igraph_integer_t> cost(n), order(n);
+    igraph_integer_t total = 0;
+    for (igraph_integer_t i = 0; i < n; ++i) {
+        const Graph g = list[i];
+        cost[i] = g.vcount() + g.ecount() + 1;
+        total += cost[i];
+    }
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](igraph_integer_t a, igraph_integer_t b) { return cost[a] > cost[b]; });
+
+#if defined(IGRAPH_THREAD_SAFE) && IGRAPH_THREAD_SAFE
+    const unsigned nthreads = thread_count();
+#else
+    const unsigned nthreads = 1;
+#endif
+
+    // Cut the ordered list into chunks of roughly equal total cost. Large graphs end
+    // up in chunks of their own, while many small ones are handed out together.
+    const igraph_integer_t target = std::max<igraph_integer_t>(1, total / (16 * igraph_integer_t(nthreads)));
+    std::vector<igraph_integer_t> bounds = {0};
+    igraph_integer_t acc = 0;
+    for (igraph_integer_t k = 0; k < n; ++k) {
+        acc += cost[order[k]];
+        if (acc >= target) {
+            bounds.push_back(k + 1);
+            acc = 0;
+        }
+    }
+    if (bounds.back() != n)
+        bounds.push_back(n);
+
+    const igraph_integer_t nchunks = bounds.size() - 1;
+    std::atomic<igraph_integer_t> next{0};
+    detail::ThreadPool::instance().run(std::min<igraph_integer_t>(nthreads, nchunks), [&](unsigned) {
+        for (;;) {
+            igraph_integer_t chunk = next.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= nchunks)
+                break;
+            for (igraph_integer_t k = bounds[chunk]; k < bounds[chunk + 1]; ++k) {
+                igraph_integer_t i = order[k];
+                result::store(res, i, f(list[i]));
+            }
+        }
+    });
+
+    return res;
+}
@@ -0,0 +1,235 @@
+
+// Multi-threaded power iteration for PageRank and eigenvector centrality.
+//
+// PowerIteration stores the graph once in compressed sparse row form, indexed by the
+// target of each edge, so that a sparse matrix-vector product pulls values along the
+// incoming edges of each vertex. Vertices are then updated independently in parallel,
+// without atomic operations. Iterations stop once successive vectors differ by less
+// than the tolerance, and may be started from the result of an earlier run, which
+// saves most of the iterations when the graph has changed only slightly.
+
+class PowerIteration {
+    igraph_integer_t n = 0;
+    std::vector<igraph_integer_t> offsets;  // in-edges of v are at offsets[v] .. offsets[v+1]-1
+    std::vector<igraph_integer_t> sources;
+    std::vector<igraph_real_t> values;      // edge weights; empty if unweighted
+    std::vector<igraph_real_t> out_strength;
+
+    igraph_real_t tol = 1e-10;
+    igraph_integer_t max_iter = 1000;
+    igraph_integer_t iter = 0;
+
+    static constexpr igraph_integer_t grain = 1 << 10;
+
+    // Calls f(v, s) for each vertex v, where s is the sum of w(u, v) * x[u] over its
+    // in-edges, and returns the sum of the results of f.
+    template<typename X, typename F>
+    igraph_real_t pull(const X &x, F f) const {
+        return detail::parallel_sum<igraph_real_t>(n, grain, [&](igraph_integer_t begin, igraph_integer_t end) {
+            igraph_real_t acc = 0;
+            for (igraph_integer_t v = begin; v < end; ++v) {
+                igraph_real_t sum = 0;
+                if (values.empty()) {
+                    for (igraph_integer_t k = offsets[v]; k < offsets[v + 1]; ++k)
+                        sum += x[sources[k]];
+                } else {
+                    for (igraph_integer_t k = offsets[v]; k < offsets[v + 1]; ++k)
+                        sum += values[k] * x[sources[k]];
+                }
+                acc += f(v, sum);
+            }
+            return acc;
+        });
+    }
+
+    // Uses 'vec' as the starting vector if requested, otherwise fills it with 'init'.
+    void start(RealVec &vec, bool warm_start, igraph_real_t init) const {
+        if (warm_start) {
+            if (vec.size() != n)
+                throw Exception(IGRAPH_EINVAL);
+        } else {
+            vec.resize(n);
+            std::fill(vec.begin(), vec.end(), init);
+        }
+    }
+
+public:
+    // Prepares power iterations on the graph. Edges are followed in their own direction,
+    // unless 'directed' is false or the graph is undirected. Weights, if given, must be
+    // non-negative.
+    template<typename G>
+    explicit PowerIteration(const G &graph, const RealVec *weights = nullptr, bool directed = true) {
+        auto &&g = view(graph);
+        n = g.vcount();
+        const igraph_neimode_t in_mode = directed ? IGRAPH_IN : IGRAPH_ALL;
+        const igraph_neimode_t out_mode = directed ? IGRAPH_OUT : IGRAPH_ALL;
+
+        if (weights) {
+            detail::check_edge_weights(g, *weights);
+            for (auto w : *weights)
+                if (! (w >= 0))
+                    throw Exception(IGRAPH_EINVAL);
+        }
+
+        offsets.resize(n + 1);
+        offsets[0] = 0;
+        for (igraph_integer_t v = 0; v < n; ++v)
+            offsets[v + 1] = offsets[v] + g.degree(v, in_mode);
+        sources.resize(offsets[n]);
+        if (weights)
+            values.resize(offsets[n]);
+        out_strength.resize(n);
+
+        detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            for (igraph_integer_t v = begin; v < end; ++v) {
+                igraph_integer_t k = offsets[v];
+                g.for_each_neighbor(v, in_mode, [&](igraph_integer_t u, igraph_integer_t e) {
+                    sources[k] = u;
+                    if (weights)
+                        values[k] = (*weights)[e];
+                    ++k;
+                });
+                igraph_real_t s = 0;
+                g.for_each_neighbor(v, out_mode, [&](igraph_integer_t, igraph_integer_t e) {
+                    s += weights ? (*weights)[e] : 1;
+                });
+                out_strength[v] = s;
+            }
+        });
+    }
+
+    igraph_integer_t vcount() const { return n; }
+
+    // Iterations stop when the L1 distance between successive vectors is below the
+    // tolerance, or after the maximum number of iterations. The defaults are 1e-10 and 1000.
+    void set_tolerance(igraph_real_t tolerance) { tol = tolerance; }
+    void set_max_iterations(igraph_integer_t count) { max_iter = count; }
+
+    // The number of iterations performed by the last call to pagerank() or
+    // eigenvector_centrality().
+    igraph_integer_t iterations() const { return iter; }
+
+    // Computes y = A^T x, i.e. y[v] is the weighted sum of x over the in-neighbours of v.
+    void multiply(const RealVec &x, RealVec &y) const {
+        if (x.size() != n)
+            throw Exception(IGRAPH_EINVAL);
+        y.resize(n);
+        pull(x, [&](igraph_integer_t v, igraph_real_t s) {
+            y[v] = s;
+            return 0;
+        });
+    }
+
+    // Computes PageRank scores, summing to one, into 'rank'. If 'reset' is given, it is
+    // the personalized PageRank with teleportation to vertices in proportion to 'reset'.
+    // Random walkers at vertices without out-edges also teleport. With 'warm_start',
+    // iterations start from the current contents of 'rank'. Returns the number of
+    // iterations.
+    igraph_integer_t pagerank(RealVec &rank, igraph_real_t damping = 0.85,
+                              const RealVec *reset = nullptr, bool warm_start = false) {
+        if (! (damping >= 0 && damping <= 1))
+            throw Exception(IGRAPH_EINVAL);
+
+        std::vector<igraph_real_t> teleport(n, n > 0 ? 1.0 / n : 0);
+        if (reset) {
+            if (reset->size() != n)
+                throw Exception(IGRAPH_EINVAL);
+            igraph_real_t sum = 0;
+            for (auto r : *reset) {
+                if (! (r >= 0))
+                    throw Exception(IGRAPH_EINVAL);
+                sum += r;
+            }
+            if (! (sum > 0))
+                throw Exception(IGRAPH_EINVAL);
+            for (igraph_integer_t v = 0; v < n; ++v)
+                teleport[v] = (*reset)[v] / sum;
+        }
+
+        start(rank, warm_start, n > 0 ? 1.0 / n : 0);
+        if (n == 0)
+            return iter = 0;
+        const igraph_real_t total = std::accumulate(rank.begin(), rank.end(), igraph_real_t(0));
+        if (! (total > 0))
+            throw Exception(IGRAPH_EINVAL);
+        for (auto &r : rank)
+            r /= total;
+
+        // scaled[u] is the share of rank[u] sent along each unit of out-weight.
+        std::vector<igraph_real_t> scaled(n), next(n);
+        for (iter = 0; iter < max_iter; ) {
+            const igraph_real_t dangling = detail::parallel_sum<igraph_real_t>(n, grain, [&](igraph_integer_t begin, igraph_integer_t end) {
+                igraph_real_t sum = 0;
+                for (igraph_integer_t u = begin; u < end; ++u) {
+                    if (out_strength[u] > 0) {
+                        scaled[u] = rank[u] / out_strength[u];
+                    } else {
+                        scaled[u] = 0;
+                        sum += rank[u];
+                    }
+                }
+                return sum;
+            });
+
+            const igraph_real_t jump = damping * dangling + (1 - damping);
+            const igraph_real_t diff = pull(scaled, [&](igraph_integer_t v, igraph_real_t s) {
+                next[v] = damping * s + jump * teleport[v];
+                return std::abs(next[v] - rank[v]);
+            });
+            std::copy(next.begin(), next.end(), rank.begin());
+            ++iter;
+            if (diff < tol)
+                break;
+        }
+
+        // Correct for the accumulation of rounding errors.
+        const igraph_real_t sum = std::accumulate(rank.begin(), rank.end(), igraph_real_t(0));
+        for (auto &r : rank)
+            r /= sum;
+
+        return iter;
+    }
+
+    // Computes eigenvector centralities into 'vec', scaled so that the largest is one.
+    // The centrality of a vertex is proportional to the sum of the centralities of its
+    // in-neighbours. If 'value' is not null, the eigenvalue is stored in it. With
+    // 'warm_start', iterations start from the current contents of 'vec'. Returns the
+    // number of iterations.
+    igraph_integer_t eigenvector_centrality(RealVec &vec, igraph_real_t *value = nullptr,
+                                            bool warm_start = false) {
+        start(vec, warm_start, 1);
+        const igraph_real_t largest = n > 0 ? *std::max_element(vec.begin(), vec.end()) : 1;
+        if (! (largest > 0))
+            throw Exception(IGRAPH_EINVAL);
+        for (auto &x : vec)
+            x /= largest;
+
+        // Iterating with A + I instead of A has the same eigenvectors, but avoids
+        // oscillation when the graph is bipartite.
+        std::vector<igraph_real_t> next(n);
+        igraph_real_t lambda = 1;
+        for (iter = 0; iter < max_iter; ) {
+            pull(vec, [&](igraph_integer_t v, igraph_real_t s) {
+                next[v] = s + vec[v];
+                return 0;
+            });
+            lambda = n > 0 ? *std::max_element(next.begin(), next.end()) : 1;
+            const igraph_real_t diff = detail::parallel_sum<igraph_real_t>(n, grain, [&](igraph_integer_t begin, igraph_integer_t end) {
+                igraph_real_t sum = 0;
+                for (igraph_integer_t v = begin; v < end; ++v) {
+                    const igraph_real_t x = next[v] / lambda;
+                    sum += std::abs(x - vec[v]);
+                    vec[v] = x;
+                }
+                return sum;
+            });
+            ++iter;
+            if (diff < tol)
+                break;
+        }
+
+        if (value)
+            *value = lambda - 1;
+        return iter;
+    }
+};
@@ -0,0 +1,167 @@
+
+// Parallel generation of random walks.
+//
+// RandomWalker samples each step from a NeighborAliasIndex, so that a step takes
+// constant time regardless of the degree, also for weighted walks. Second-order
+// node2vec walks are sampled by rejection: a candidate is drawn from the first-order
+// distribution, and accepted with a probability proportional to its node2vec bias,
+// which requires a binary search in the sorted neighbour list of the previous vertex.
+//
+// Each walk draws its random numbers from its own RNGStream, identified by the index
+// of the walk. Walks are therefore reproducible from the state of igraph's random
+// number generator, independently of the number of threads and of how they are
+// divided into chunks.
+
+namespace detail {
+
+// Appends the decimal representation of x to s.
+inline void append_integer(std::string &s, igraph_integer_t x) {
+    char buf[24];
+    char *p = buf + sizeof(buf);
+    const bool negative = x < 0;
+    std::uint64_t u = negative ? 0 - std::uint64_t(x) : std::uint64_t(x);
+    do {
+        *--p = char('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (negative)
+        *--p = '-';
+    s.append(p, buf + sizeof(buf));
+}
+
+} // namespace detail
+
+class RandomWalker {
+    NeighborAliasIndex index;
+    igraph_real_t return_bias = 1, in_out_bias = 1, max_bias = 1;
+    bool second_order = false;
+
+    static constexpr igraph_integer_t grain = 256;
+
+public:
+    // Prepares random walks on a graph, which may be a Graph or any of its views. If
+    // 'weights' is given, each step follows an edge with probability proportional to
+    // its weight; edges of zero weight are never followed. The mode determines whether
+    // walks follow edges in their direction (IGRAPH_OUT), against it (IGRAPH_IN) or
+    // both (IGRAPH_ALL); it is ignored for undirected graphs.
+    template<typename G>
+    explicit RandomWalker(const G &graph, const RealVec *weights = nullptr, igraph_neimode_t mode = IGRAPH_OUT) :
+        index(graph, weights, mode) { }
+
+    igraph_integer_t vcount() const { return index.vcount(); }
+
+    // Turns the walks into second-order node2vec walks. After a step from t to v, the
+    // probability of moving on to x is multiplied by 1/p if x is t, by 1 if x is a
+    // neighbour of t, and by 1/q otherwise. p = q = 1 gives first-order walks.
+    void set_node2vec(igraph_real_t p, igraph_real_t q) {
+        if (! (p > 0 && q > 0 && p < IGRAPH_INFINITY && q < IGRAPH_INFINITY))
+            throw Exception(IGRAPH_EINVAL);
+        return_bias = 1 / p;
+        in_out_bias = 1 / q;
+        max_bias = std::max({return_bias, igraph_real_t(1), in_out_bias});
+        second_order = p != 1 || q != 1;
+    }
+
+    // Generates a walk of 'length' vertices from each vertex in 'starts', using multiple
+    // threads. Column j of the result holds the walk from 'starts[j]'. When a walk
+    // reaches a vertex without neighbours to move to, the rest of its column is -1.
+    IntMat walks(const IntVec &starts, igraph_integer_t length) const {
+        check_walks(starts, length);
+        IntMat res(length, starts.size());
+        generate(starts, 0, starts.size(), length, res, RNGStream::seed_from_igraph());
+        return res;
+    }
+
+    // Generates the same walks as walks(), but 'chunk_size' walks at a time, and calls
+    // f(chunk, first) for each chunk in order, where column j of 'chunk' is the walk
+    // from 'starts[first + j]'. Use this when all the walks would not fit in memory.
+    template<typename F>
+    void for_each_chunk(const IntVec &starts, igraph_integer_t length, F &&f,
+                        igraph_integer_t chunk_size = 1 << 16) const {
+        check_walks(starts, length);
+        if (chunk_size < 1)
+            throw Exception(IGRAPH_EINVAL);
+        const std::uint64_t seed = RNGStream::seed_from_igraph();
+        const igraph_integer_t count = starts.size();
+        IntMat chunk;
+        for (igraph_integer_t first = 0; first < count; first += chunk_size) {
+            const igraph_integer_t size = std::min(chunk_size, count - first);
+            chunk.resize(length, size);
+            generate(starts, first, size, length, chunk, seed);
+            f(static_cast<const IntMat &>(chunk), first);
+        }
+    }
+
+    // Writes the same walks as walks() to a file, one walk per line, with vertex IDs
+    // separated by spaces. Walks that end early are written without padding.
+    void write(std::FILE *file, const IntVec &starts, igraph_integer_t length,
+               igraph_integer_t chunk_size = 1 << 16) const {
+        std::vector<std::string> text(thread_count());
+        for_each_chunk(starts, length, [&](const IntMat &chunk, igraph_integer_t) {
+            // Lines are formatted in parallel, in contiguous blocks of walks per thread.
+            const igraph_integer_t size = chunk.ncol();
+            const unsigned parts = text.size();
+            detail::parallel_threads([&](unsigned tid) {
+                std::string &s = text[tid];
+                s.clear();
+                for (igraph_integer_t j = size * tid / parts; j < size * (tid + 1) / parts; ++j) {
+                    for (igraph_integer_t i = 0; i < length && chunk(i, j) >= 0; ++i) {
+                        if (i > 0)
+                            s.push_back(' ');
+                        detail::append_integer(s, chunk(i, j));
+                    }
+                    s.push_back('\n');
+                }
+            });
+            for (const auto &s : text)
+                if (std::fwrite(s.data(), 1, s.size(), file) != s.size())
+                    throw Exception(IGRAPH_EFILE);
+        }, chunk_size);
+    }
+
+private:
+    void check_walks(const IntVec &starts, igraph_integer_t length) const {
+        if (length < 0)
+            throw Exception(IGRAPH_EINVAL);
+        for (auto v : starts)
+            if (v < 0 || v >= index.vcount())
+                throw Exception(IGRAPH_EINVVID);
+    }
+
+    // Generates the walks from 'starts[first .. first+count-1]' into the columns of 'res'.
+    void generate(const IntVec &starts, igraph_integer_t first, igraph_integer_t count,
+                  igraph_integer_t length, IntMat &res, std::uint64_t seed) const {
+        if (length == 0)
+            return;
+        detail::parallel_for(count, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            for (igraph_integer_t j = begin; j < end; ++j) {
+                RNGStream rng(seed, first + j);
+                igraph_integer_t *walk = &res(0, j);
+                igraph_integer_t prev = -1, cur = starts[first + j];
+                walk[0] = cur;
+                for (igraph_integer_t i = 1; i < length; ++i) {
+                    if (cur >= 0) {
+                        const igraph_integer_t next = step(prev, cur, rng);
+                        prev = cur;
+                        cur = next;
+                    }
+                    walk[i] = cur;
+                }
+            }
+        });
+    }
+
+    igraph_integer_t step(igraph_integer_t prev, igraph_integer_t cur, RNGStream &rng) const {
+        if (prev < 0 || ! second_order)
+            return index.sample_neighbor(cur, rng);
+        for (;;) {
+            const igraph_integer_t next = index.sample_neighbor(cur, rng);
+            if (next < 0)
+                return next;
+            const igraph_real_t bias = next == prev ? return_bias :
+                                       index.is_neighbor(prev, next) ? 1 : in_out_bias;
+            if (rng.unif01() * max_bias < bias)
+                return next;
+        }
+    }
+};
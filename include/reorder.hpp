@@ -0,0 +1,269 @@
+
+// Vertex reordering for cache locality.
+//
+// Graph algorithms access the data of neighbouring vertices together, so they run
+// faster when neighbours have nearby IDs. The orderings below are computed once, and
+// the graph, along with its vertex attributes, is relabelled accordingly. All methods
+// ignore edge directions.
+//
+//  - Degree: vertices in order of decreasing degree, which groups the hubs together.
+//  - BFS: breadth-first search order, starting from each unvisited vertex in turn.
+//  - RCM: reverse Cuthill-McKee, which reduces the bandwidth of the adjacency matrix.
+//    Each component is traversed breadth-first from a pseudo-peripheral vertex, visiting
+//    neighbours in order of increasing degree, and the resulting order is reversed.
+//  - Gorder: a greedy heuristic after Wei et al. Each next vertex maximizes the number
+//    of vertices among the last few placed ones that it is adjacent to, or shares a
+//    neighbour with. Scores are kept in a bucket queue, as they only change by one at
+//    a time. Neighbours of hubs are not counted as siblings, to bound the running time.
+
+enum class ReorderMethod { Degree, BFS, RCM, Gorder };
+
+namespace detail {
+
+constexpr igraph_integer_t gorder_window = 5;
+
+// Max-priority queue of vertices with integer keys that change by one at a time.
+class UnitHeap {
+    std::vector<igraph_integer_t> key, prev, next, head;
+    std::vector<char> removed;
+    igraph_integer_t top = 0;
+
+    void unlink(igraph_integer_t v) {
+        if (prev[v] >= 0)
+            next[prev[v]] = next[v];
+        else
+            head[key[v]] = next[v];
+        if (next[v] >= 0)
+            prev[next[v]] = prev[v];
+    }
+
+    void link(igraph_integer_t v) {
+        if (key[v] >= igraph_integer_t(head.size()))
+            head.resize(key[v] + 1, -1);
+        prev[v] = -1;
+        next[v] = head[key[v]];
+        if (next[v] >= 0)
+            prev[next[v]] = v;
+        head[key[v]] = v;
+        top = std::max(top, key[v]);
+    }
+
+public:
+    // All vertices start with key 0. Among equal keys, the smallest ID comes first.
+    explicit UnitHeap(igraph_integer_t n) : key(n, 0), prev(n), next(n), head(1, -1), removed(n, false) {
+        for (igraph_integer_t v = n - 1; v >= 0; --v)
+            link(v);
+    }
+
+    // Adds 'delta' to the key of v, unless v was removed.
+    void change(igraph_integer_t v, igraph_integer_t delta) {
+        if (removed[v])
+            return;
+        unlink(v);
+        key[v] += delta;
+        link(v);
+    }
+
+    void remove(igraph_integer_t v) {
+        unlink(v);
+        removed[v] = true;
+    }
+
+    // Removes and returns a vertex with the largest key, or -1 if there are none.
+    igraph_integer_t pop() {
+        while (top > 0 && head[top] < 0)
+            --top;
+        const igraph_integer_t v = head[top];
+        if (v >= 0)
+            remove(v);
+        return v;
+    }
+};
+
+template<typename G>
+void breadth_first_order(const G &g, igraph_integer_t root, bool by_degree,
+                         const std::vector<igraph_integer_t> &degree, std::vector<char> &seen,
+                         std::vector<igraph_integer_t> &order, std::vector<igraph_integer_t> &neis) {
+    std::size_t head = order.size();
+    order.push_back(root);
+    seen[root] = true;
+    while (head < order.size()) {
+        const igraph_integer_t v = order[head++];
+        neis.clear();
+        g.for_each_neighbor(v, IGRAPH_ALL, [&](igraph_integer_t u, igraph_integer_t) {
+            if (! seen[u]) {
+                seen[u] = true;
+                neis.push_back(u);
+            }
+        });
+        if (by_degree)
+            std::stable_sort(neis.begin(), neis.end(), [&](igraph_integer_t a, igraph_integer_t b) {
+                return degree[a] < degree[b];
+            });
+        order.insert(order.end(), neis.begin(), neis.end());
+    }
+}
+
+// Finds a pseudo-peripheral vertex of the component of 'root' (George and Liu): move to
+// a vertex of smallest degree in the last level of a BFS, while the eccentricity grows.
+// 'level' must be all -1, and is restored; 'queue' is working space.
+template<typename G>
+igraph_integer_t pseudo_peripheral_vertex(const G &g, igraph_integer_t root,
+                                          const std::vector<igraph_integer_t> &degree,
+                                          std::vector<igraph_integer_t> &level,
+                                          std::vector<igraph_integer_t> &queue) {
+    igraph_integer_t eccentricity = -1;
+    for (;;) {
+        queue.assign(1, root);
+        level[root] = 0;
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            const igraph_integer_t v = queue[head];
+            g.for_each_neighbor(v, IGRAPH_ALL, [&](igraph_integer_t u, igraph_integer_t) {
+                if (level[u] < 0) {
+                    level[u] = level[v] + 1;
+                    queue.push_back(u);
+                }
+            });
+        }
+
+        const igraph_integer_t depth = level[queue.back()];
+        igraph_integer_t best = queue.back();
+        for (auto it = queue.rbegin(); it != queue.rend() && level[*it] == depth; ++it)
+            if (degree[*it] < degree[best])
+                best = *it;
+        for (auto v : queue)
+            level[v] = -1;
+
+        if (depth <= eccentricity)
+            return root;
+        eccentricity = depth;
+        root = best;
+    }
+}
+
+} // namespace detail
+
+// Computes a vertex ordering of a graph for better cache locality, see above. Returns
+// the permutation: the new ID of vertex v is 'perm[v]'.
+template<typename G>
+IntVec reorder_permutation(const G &graph, ReorderMethod method) {
+    auto &&g = view(graph);
+    const igraph_integer_t n = g.vcount();
+
+    std::vector<igraph_integer_t> degree(n);
+    for (igraph_integer_t v = 0; v < n; ++v)
+        degree[v] = g.degree(v, IGRAPH_ALL);
+
+    // The vertices in their new order.
+    std::vector<igraph_integer_t> order;
+    order.reserve(n);
+
+    switch (method) {
+    case ReorderMethod::Degree:
+        order.resize(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](igraph_integer_t a, igraph_integer_t b) {
+            return degree[a] > degree[b];
+        });
+        break;
+
+    case ReorderMethod::BFS:
+    case ReorderMethod::RCM: {
+        const bool rcm = method == ReorderMethod::RCM;
+        std::vector<char> seen(n, false);
+        std::vector<igraph_integer_t> roots(n), neis, level(n, -1), queue;
+        std::iota(roots.begin(), roots.end(), 0);
+        // Cuthill-McKee starts each component from a vertex of small degree.
+        if (rcm)
+            std::stable_sort(roots.begin(), roots.end(), [&](igraph_integer_t a, igraph_integer_t b) {
+                return degree[a] < degree[b];
+            });
+        for (auto root : roots) {
+            if (seen[root])
+                continue;
+            if (rcm)
+                root = detail::pseudo_peripheral_vertex(g, root, degree, level, queue);
+            detail::breadth_first_order(g, root, rcm, degree, seen, order, neis);
+        }
+        if (rcm)
+            std::reverse(order.begin(), order.end());
+        break;
+    }
+
+    case ReorderMethod::Gorder: {
+        const igraph_integer_t hub = std::max<igraph_integer_t>(16, std::sqrt(igraph_real_t(n)));
+        detail::UnitHeap heap(n);
+
+        // Updates the scores of the vertices related to v, as v enters (+1) or leaves
+        // (-1) the window.
+        auto update = [&](igraph_integer_t v, igraph_integer_t delta) {
+            g.for_each_neighbor(v, IGRAPH_ALL, [&](igraph_integer_t u, igraph_integer_t) {
+                heap.change(u, delta);
+                if (degree[u] > hub)
+                    return;
+                g.for_each_neighbor(u, IGRAPH_ALL, [&](igraph_integer_t w, igraph_integer_t) {
+                    if (w != v)
+                        heap.change(w, delta);
+                });
+            });
+        };
+
+        if (n > 0) {
+            const igraph_integer_t first = std::max_element(degree.begin(), degree.end()) - degree.begin();
+            heap.remove(first);
+            order.push_back(first);
+            update(first, 1);
+        }
+        while (igraph_integer_t(order.size()) < n) {
+            if (igraph_integer_t(order.size()) > detail::gorder_window)
+                update(order[order.size() - 1 - detail::gorder_window], -1);
+            const igraph_integer_t v = heap.pop();
+            order.push_back(v);
+            update(v, 1);
+        }
+        break;
+    }
+
+    default:
+        throw Exception(IGRAPH_EINVAL);
+    }
+
+    IntVec perm(n);
+    for (igraph_integer_t i = 0; i < n; ++i)
+        perm[order[i]] = i;
+    return perm;
+}
+
+// Relabels the vertices of a graph: vertex v becomes vertex 'perm[v]'. Edges, and their
+// attributes, keep their IDs.
+inline Graph permute_vertices(const Graph &graph, const IntVec &perm) {
+    igraph_t res;
+    check(igraph_permute_vertices(graph, &res, perm));
+    return Graph(Capture(res));
+}
+
+// Reorders the values associated with vertices to match a graph relabelled with
+// permute_vertices(): element v of 'values' becomes element 'perm[v]'.
+template<typename T>
+Vec<T> permute_values(const Vec<T> &values, const IntVec &perm) {
+    if (values.size() != perm.size())
+        throw Exception(IGRAPH_EINVAL);
+    Vec<T> res(values.size());
+    for (igraph_integer_t i = 0; i < values.size(); ++i)
+        res[perm[i]] = values[i];
+    return res;
+}
+
+struct ReorderResult {
+    // The new ID of each vertex.
+    IntVec permutation;
+    // The relabelled graph.
+    Graph graph;
+};
+
+// Reorders the vertices of a graph for better cache locality, see above.
+inline ReorderResult reorder(const Graph &graph, ReorderMethod method) {
+    IntVec perm = reorder_permutation(graph, method);
+    Graph res = permute_vertices(graph, perm);
+    return ReorderResult{std::move(perm), std::move(res)};
+}
@@ -37,3 +37,71 @@ public:
         igraph_rng_destroy(&current);
     }
 };
+
+// A fast random number generator (xoshiro256**) for use within parallel routines, where
+// igraph's default generator cannot be shared between threads. Each (seed, stream) pair
+// gives an independent sequence. It satisfies the UniformRandomBitGenerator requirements,
+// so it can also be used with the distributions of <random>.
+class RNGStream {
+    std::uint64_t s[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    static std::uint64_t splitmix64(std::uint64_t &x) {
+        std::uint64_t z = (x += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+public:
+    using result_type = std::uint64_t;
+
+    explicit RNGStream(std::uint64_t seed, std::uint64_t stream = 0) {
+        std::uint64_t x = seed;
+        x = splitmix64(x) ^ stream;
+        for (auto &w : s)
+            w = splitmix64(x);
+    }
+
+    // Seeds a generator from igraph's default random number generator, so that results
+    // are reproducible within an RNGScope with a fixed seed.
+    static std::uint64_t seed_from_igraph() {
+        const std::uint64_t hi = igraph_rng_get_integer(igraph_rng_default(), 0, (1 << 30) - 1);
+        const std::uint64_t mid = igraph_rng_get_integer(igraph_rng_default(), 0, (1 << 30) - 1);
+        const std::uint64_t lo = igraph_rng_get_integer(igraph_rng_default(), 0, (1 << 30) - 1);
+        return (hi << 60) ^ (mid << 30) ^ lo;
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+    result_type operator () () {
+        const std::uint64_t res = rotl(s[1] * 5, 7) * 9;
+        const std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return res;
+    }
+
+    // A uniformly distributed integer in [0, n), with n > 0.
+    igraph_integer_t integer(igraph_integer_t n) {
+        // Reject the lowest 2^64 mod n values, so that all remainders are equally likely.
+        const std::uint64_t range = n;
+        const std::uint64_t threshold = (0 - range) % range;
+        std::uint64_t x;
+        do {
+            x = (*this)();
+        } while (x < threshold);
+        return x % range;
+    }
+
+    // A uniformly distributed real number in [0, 1).
+    igraph_real_t unif01() {
+        return ((*this)() >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
@@ -0,0 +1,471 @@
+
+// Out-of-core processing of graphs that do not fit in memory.
+//
+// ShardedGraph partitions the edges of a graph into files on disk (shards), by the
+// interval of their source vertex, in the style of GraphChi and X-Stream. Within a
+// shard, edges are sorted by target, so that an edge-centric pass can split each shard
+// among threads at target boundaries, and every target is updated by a single thread.
+// Kernels stream the shards sequentially; a separate thread reads the next shard from
+// disk while the current one is processed.
+//
+// Only one or two shards are held in memory at a time. The state of the vertices is
+// kept in vectors of size vcount(), which can themselves be backed by files with
+// MappedVec. Undirected edges are stored in both orientations. For directed graphs,
+// a second set of shards holds the reversed edges, so that kernels can follow edges
+// in either direction.
+
+// A RealVec or IntVec whose elements are stored in a file mapped into memory, so that
+// the operating system pages them in and out as needed. Where memory mapping is not
+// available, the elements are held in memory. The vector must not be resized.
+template<typename T>
+class MappedVec {
+    using igraph_type = typename Vec<T>::igraph_type;
+
+    igraph_integer_t n;
+    T *data = nullptr;
+#if defined(__unix__) || defined(__APPLE__)
+    int fd = -1;
+#else
+    std::vector<T> storage;
+#endif
+    igraph_type raw;
+    Vec<T> alias;
+
+public:
+    // Maps 'size' elements of the file at 'path', creating or extending the file as
+    // needed; new elements are zero. A temporary file is deleted once it is mapped.
+    MappedVec(const std::string &path, igraph_integer_t size, bool temporary = false) :
+        n(size), alias(Alias(raw)) {
+        if (size < 0)
+            throw Exception(IGRAPH_EINVAL);
+#if defined(__unix__) || defined(__APPLE__)
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0)
+            throw Exception(IGRAPH_EFILE);
+        if (temporary)
+            ::unlink(path.c_str());
+        const std::size_t bytes = std::max<std::size_t>(1, size * sizeof(T));
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || (std::size_t(st.st_size) < bytes && ::ftruncate(fd, bytes) != 0)) {
+            ::close(fd);
+            throw Exception(IGRAPH_EFILE);
+        }
+        void *p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            throw Exception(IGRAPH_EFILE);
+        }
+        data = static_cast<T *>(p);
+#else
+        (void) path;
+        (void) temporary;
+        storage.resize(size);
+        data = storage.data();
+#endif
+        raw.stor_begin = data;
+        raw.stor_end = raw.end = data + size;
+    }
+
+    MappedVec(const MappedVec &) = delete;
+    MappedVec & operator = (const MappedVec &) = delete;
+
+    ~MappedVec() {
+#if defined(__unix__) || defined(__APPLE__)
+        ::munmap(data, std::max<std::size_t>(1, n * sizeof(T)));
+        ::close(fd);
+#endif
+    }
+
+    // The elements, as a vector that can be passed to functions taking a RealVec or IntVec.
+    Vec<T> &vec() { return alias; }
+    const Vec<T> &vec() const { return alias; }
+};
+
+class ShardedGraph {
+public:
+    struct Edge {
+        igraph_integer_t from, to;
+    };
+
+private:
+    std::string prefix;
+    igraph_integer_t n, m = 0;
+    bool directed;
+    igraph_integer_t shards, interval;
+    bool finished = false;
+
+    // Forward shards hold the edges by source interval; reverse shards, used for
+    // directed graphs, hold the reversed edges.
+    std::vector<std::FILE *> files[2];
+    std::vector<std::vector<Edge>> buffers[2];
+    std::vector<igraph_integer_t> counts[2];
+    // Whether this object created each shard file, and must remove it.
+    std::vector<char> created[2];
+
+    static constexpr std::size_t buffer_size = 1 << 14;
+    static constexpr igraph_integer_t grain = 1 << 12;
+
+    std::string path(int dir, igraph_integer_t shard) const {
+        return prefix + (dir ? ".rev." : ".fwd.") + std::to_string(shard);
+    }
+
+    void flush(int dir, igraph_integer_t shard) {
+        auto &buf = buffers[dir][shard];
+        if (std::fwrite(buf.data(), sizeof(Edge), buf.size(), files[dir][shard]) != buf.size())
+            throw Exception(IGRAPH_EFILE);
+        buf.clear();
+    }
+
+    void push(int dir, igraph_integer_t from, igraph_integer_t to) {
+        const igraph_integer_t shard = from / interval;
+        auto &buf = buffers[dir][shard];
+        buf.push_back(Edge{from, to});
+        counts[dir][shard]++;
+        if (buf.size() >= buffer_size)
+            flush(dir, shard);
+    }
+
+    void close_files() {
+        for (auto &dir : files)
+            for (auto &f : dir)
+                if (f) {
+                    std::fclose(f);
+                    f = nullptr;
+                }
+    }
+
+    void remove_files() const {
+        for (int dir = 0; dir < 2; ++dir)
+            for (igraph_integer_t s = 0; s < igraph_integer_t(created[dir].size()); ++s)
+                if (created[dir][s])
+                    std::remove(path(dir, s).c_str());
+    }
+
+    void read_shard(int dir, igraph_integer_t shard, std::vector<Edge> &edges) const {
+        edges.resize(counts[dir][shard]);
+        std::FILE *f = std::fopen(path(dir, shard).c_str(), "rb");
+        if (! f)
+            throw Exception(IGRAPH_EFILE);
+        const std::size_t read = std::fread(edges.data(), sizeof(Edge), edges.size(), f);
+        std::fclose(f);
+        if (read != edges.size())
+            throw Exception(IGRAPH_EFILE);
+    }
+
+    // Calls f(edges) for the sorted edges of each shard in turn, reading the next
+    // shard in a separate thread.
+    template<typename F>
+    void stream(int dir, F &&f) const {
+        if (! finished)
+            throw Exception(IGRAPH_EINVAL);
+        std::vector<Edge> current, next;
+        read_shard(dir, 0, current);
+        for (igraph_integer_t shard = 0; shard < shards; ++shard) {
+            std::exception_ptr error;
+            std::thread prefetch;
+            if (shard + 1 < shards)
+                prefetch = std::thread([&] {
+                    try {
+                        read_shard(dir, shard + 1, next);
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                });
+            try {
+                f(static_cast<const std::vector<Edge> &>(current));
+            } catch (...) {
+                if (prefetch.joinable())
+                    prefetch.join();
+                throw;
+            }
+            if (prefetch.joinable())
+                prefetch.join();
+            if (error)
+                std::rethrow_exception(error);
+            current.swap(next);
+        }
+    }
+
+    // Calls f(from, to) for each edge in the direction given by the mode, using multiple
+    // threads. Calls for the same 'to' vertex are made by the same thread, in order.
+    template<typename F>
+    void gather(igraph_neimode_t mode, F &&f) const {
+        auto process = [&](const std::vector<Edge> &edges) {
+            // Split the edges into blocks that start at a new target.
+            const std::size_t count = edges.size();
+            std::vector<std::size_t> bounds(1, 0);
+            for (std::size_t b = grain; b < count; b += grain) {
+                std::size_t k = std::max(b, bounds.back());
+                while (k < count && edges[k].to == edges[k - 1].to)
+                    ++k;
+                if (k > bounds.back() && k < count)
+                    bounds.push_back(k);
+            }
+            bounds.push_back(count);
+            detail::parallel_for(bounds.size() - 1, 1, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+                for (igraph_integer_t block = begin; block < end; ++block)
+                    for (std::size_t k = bounds[block]; k < bounds[block + 1]; ++k)
+                        f(edges[k].from, edges[k].to);
+            });
+        };
+        // Undirected edges are stored in both orientations in the forward shards.
+        if (! directed || (mode & IGRAPH_OUT))
+            stream(0, process);
+        if (directed && (mode & IGRAPH_IN))
+            stream(1, process);
+    }
+
+    std::string temporary_path(const char *name) const {
+        return prefix + ".tmp." + name;
+    }
+
+public:
+    // Creates an empty graph with n vertices, whose edges will be stored in 'shards'
+    // files named after 'prefix'. Each shard should fit comfortably in memory, twice.
+    // The files are deleted when the object is destroyed.
+    ShardedGraph(const std::string &prefix, igraph_integer_t n, bool directed, igraph_integer_t shards) :
+        prefix(prefix), n(n), directed(directed), shards(shards) {
+        if (n < 1 || shards < 1)
+            throw Exception(IGRAPH_EINVAL);
+        this->shards = std::min(shards, n);
+        interval = (n + this->shards - 1) / this->shards;
+        this->shards = (n + interval - 1) / interval;
+
+        for (int dir = 0; dir < (directed ? 2 : 1); ++dir) {
+            files[dir].assign(this->shards, nullptr);
+            buffers[dir].resize(this->shards);
+            counts[dir].assign(this->shards, 0);
+            created[dir].assign(this->shards, false);
+            for (igraph_integer_t s = 0; s < this->shards; ++s) {
+                files[dir][s] = std::fopen(path(dir, s).c_str(), "wb");
+                if (! files[dir][s]) {
+                    close_files();
+                    remove_files();
+                    throw Exception(IGRAPH_EFILE);
+                }
+                created[dir][s] = true;
+            }
+        }
+    }
+
+    ShardedGraph(const ShardedGraph &) = delete;
+    ShardedGraph & operator = (const ShardedGraph &) = delete;
+
+    ~ShardedGraph() {
+        close_files();
+        remove_files();
+    }
+
+    igraph_integer_t vcount() const { return n; }
+    igraph_integer_t ecount() const { return m; }
+    bool is_directed() const { return directed; }
+    igraph_integer_t shard_count() const { return shards; }
+
+    void add_edge(igraph_integer_t from, igraph_integer_t to) {
+        if (finished)
+            throw Exception(IGRAPH_EINVAL);
+        if (from < 0 || from >= n || to < 0 || to >= n)
+            throw Exception(IGRAPH_EINVVID);
+        push(0, from, to);
+        if (directed)
+            push(1, to, from);
+        else
+            push(0, to, from);
+        ++m;
+    }
+
+    // Adds edges given as consecutive pairs of vertex IDs.
+    void add_edges(const IntVec &edges) {
+        if (edges.size() % 2 != 0)
+            throw Exception(IGRAPH_EINVAL);
+        for (igraph_integer_t i = 0; i < edges.size(); i += 2)
+            add_edge(edges[i], edges[i + 1]);
+    }
+
+    // Adds edges read from a text file, in the format of igraph_read_graph_edgelist():
+    // pairs of vertex IDs separated by white space.
+    void add_edges(std::FILE *file) {
+        std::vector<char> buf(1 << 16);
+        igraph_integer_t value = 0, pending = -1;
+        bool in_number = false;
+        auto end_number = [&] {
+            if (pending < 0) {
+                pending = value;
+            } else {
+                add_edge(pending, value);
+                pending = -1;
+            }
+            value = 0;
+            in_number = false;
+        };
+        std::size_t len;
+        while ((len = std::fread(buf.data(), 1, buf.size(), file)) > 0) {
+            for (std::size_t i = 0; i < len; ++i) {
+                const char c = buf[i];
+                if (c >= '0' && c <= '9') {
+                    if (value > (IGRAPH_INTEGER_MAX - 9) / 10)
+                        throw Exception(IGRAPH_PARSEERROR);
+                    value = 10 * value + (c - '0');
+                    in_number = true;
+                } else if (c == ' ' || c == '\n' || c == '\t' || c == '\r') {
+                    if (in_number)
+                        end_number();
+                } else {
+                    throw Exception(IGRAPH_PARSEERROR);
+                }
+            }
+        }
+        if (in_number)
+            end_number();
+        if (std::ferror(file))
+            throw Exception(IGRAPH_EFILE);
+        if (pending >= 0)
+            throw Exception(IGRAPH_PARSEERROR);
+    }
+
+    // Writes the remaining edges, and sorts each shard by target. Must be called after
+    // adding the edges, and before running any kernels.
+    void finish() {
+        if (finished)
+            return;
+        for (int dir = 0; dir < (directed ? 2 : 1); ++dir)
+            for (igraph_integer_t s = 0; s < shards; ++s)
+                flush(dir, s);
+        close_files();
+
+        std::vector<Edge> edges;
+        for (int dir = 0; dir < (directed ? 2 : 1); ++dir) {
+            for (igraph_integer_t s = 0; s < shards; ++s) {
+                read_shard(dir, s, edges);
+                std::sort(edges.begin(), edges.end(), [](const Edge &a, const Edge &b) {
+                    return a.to < b.to || (a.to == b.to && a.from < b.from);
+                });
+                std::FILE *f = std::fopen(path(dir, s).c_str(), "wb");
+                if (! f)
+                    throw Exception(IGRAPH_EFILE);
+                const std::size_t written = std::fwrite(edges.data(), sizeof(Edge), edges.size(), f);
+                if (std::fclose(f) != 0 || written != edges.size())
+                    throw Exception(IGRAPH_EFILE);
+            }
+        }
+        finished = true;
+    }
+
+    // Calls f(from, to) for each edge, in the given mode, with multiple threads: with
+    // IGRAPH_OUT, edges are visited in their direction, with IGRAPH_IN reversed, and with
+    // IGRAPH_ALL both ways. Undirected edges are always visited both ways. All calls for
+    // the same 'to' vertex are made from the same thread, so f may update data
+    // associated with 'to' without synchronization.
+    template<typename F>
+    void for_each_edge(igraph_neimode_t mode, F &&f) const {
+        detail::check_mode(mode);
+        gather(mode, f);
+    }
+
+    // Computes the degree of each vertex into 'res', which must have vcount() elements.
+    // Self-loops count twice in undirected graphs and with IGRAPH_ALL.
+    void degree(IntVec &res, igraph_neimode_t mode = IGRAPH_ALL) const {
+        detail::check_mode(mode);
+        if (res.size() != n)
+            throw Exception(IGRAPH_EINVAL);
+        detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            std::fill(res.begin() + begin, res.begin() + end, 0);
+        });
+        // An out-edge of v is an edge to v when visited reversed.
+        gather(detail::reverse_mode(mode), [&](igraph_integer_t, igraph_integer_t to) {
+            res[to]++;
+        });
+    }
+
+    // Computes the PageRank of the vertices into 'res', which must have vcount()
+    // elements, by power iteration, until the L1 change is below 'tolerance', or for at
+    // most 'max_iterations' iterations. Returns the number of iterations. Scratch
+    // vectors are stored in files named after the prefix.
+    igraph_integer_t pagerank(RealVec &res, igraph_real_t damping = 0.85,
+                              igraph_real_t tolerance = 1e-10, igraph_integer_t max_iterations = 1000) const {
+        if (res.size() != n || ! (damping >= 0 && damping <= 1))
+            throw Exception(IGRAPH_EINVAL);
+
+        MappedVec<igraph_integer_t> outdeg(temporary_path("outdeg"), n, true);
+        MappedVec<igraph_real_t> next(temporary_path("pagerank"), n, true);
+        degree(outdeg.vec(), IGRAPH_OUT);
+        const IntVec &deg = outdeg.vec();
+        RealVec &x = next.vec();
+
+        detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            std::fill(res.begin() + begin, res.begin() + end, 1.0 / n);
+        });
+
+        igraph_integer_t iter = 0;
+        while (iter < max_iterations) {
+            ++iter;
+            // Dangling vertices distribute their rank uniformly.
+            const igraph_real_t dangling = detail::parallel_sum<igraph_real_t>(n, grain, [&](igraph_integer_t begin, igraph_integer_t end) {
+                igraph_real_t sum = 0;
+                for (igraph_integer_t v = begin; v < end; ++v)
+                    if (deg[v] == 0)
+                        sum += res[v];
+                return sum;
+            });
+            const igraph_real_t base = (1 - damping) / n + damping * dangling / n;
+            detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+                std::fill(x.begin() + begin, x.begin() + end, base);
+            });
+            gather(IGRAPH_OUT, [&](igraph_integer_t from, igraph_integer_t to) {
+                x[to] += damping * res[from] / deg[from];
+            });
+            const igraph_real_t change = detail::parallel_sum<igraph_real_t>(n, grain, [&](igraph_integer_t begin, igraph_integer_t end) {
+                igraph_real_t sum = 0;
+                for (igraph_integer_t v = begin; v < end; ++v) {
+                    sum += std::abs(x[v] - res[v]);
+                    res[v] = x[v];
+                }
+                return sum;
+            });
+            if (change < tolerance)
+                break;
+        }
+        return iter;
+    }
+
+    // Computes the weakly connected components into 'membership', which must have
+    // vcount() elements, by propagating the smallest vertex ID of each component.
+    // Components are numbered in the order of their smallest vertex. Returns the number
+    // of components.
+    igraph_integer_t connected_components(IntVec &membership) const {
+        if (membership.size() != n)
+            throw Exception(IGRAPH_EINVAL);
+
+        MappedVec<igraph_integer_t> next(temporary_path("components"), n, true);
+        IntVec &label = membership, &x = next.vec();
+        detail::parallel_for(n, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            for (igraph_integer_t v = begin; v < end; ++v)
+                label[v] = x[v] = v;
+        });
+
+        for (;;) {
+            gather(IGRAPH_ALL, [&](igraph_integer_t from, igraph_integer_t to) {
+                x[to] = std::min(x[to], label[from]);
+            });
+            const igraph_integer_t changes = detail::parallel_sum<igraph_integer_t>(n, grain, [&](igraph_integer_t begin, igraph_integer_t end) {
+                igraph_integer_t count = 0;
+                for (igraph_integer_t v = begin; v < end; ++v) {
+                    if (x[v] != label[v]) {
+                        label[v] = x[v];
+                        ++count;
+                    }
+                }
+                return count;
+            });
+            if (changes == 0)
+                break;
+        }
+
+        // Each label is the smallest vertex of its component, which is numbered before
+        // the other vertices are visited.
+        igraph_integer_t count = 0;
+        for (igraph_integer_t v = 0; v < n; ++v)
+            membership[v] = label[v] == v ? count++ : membership[label[v]];
+        return count;
+    }
+};
@@ -0,0 +1,257 @@
+
+// Sparse matrices.
+//
+// SparseMat wraps igraph_sparsemat_t, which is either in triplet form, suitable for
+// adding entries, or in column-compressed form, used by igraph's sparse matrix routines.
+// For repeated products, CSRMat holds a read-only copy in compressed sparse row form,
+// where each row of the result can be computed independently by a separate thread.
+
+class SparseMat {
+public:
+    using igraph_type = igraph_sparsemat_t;
+    using size_type = igraph_integer_t;
+
+private:
+    igraph_type mat;
+    igraph_type *ptr = &mat;
+
+    bool is_alias() const { return ptr != &mat; }
+
+public:
+    explicit SparseMat(CaptureType<igraph_type> m) : mat(m.obj) { }
+    explicit SparseMat(AliasType<igraph_type> m) : ptr(&m.obj) { }
+
+    // Creates an empty matrix in triplet form, with space for 'nzmax' entries.
+    explicit SparseMat(size_type n = 0, size_type m = 0, size_type nzmax = 0) {
+        check(igraph_sparsemat_init(ptr, n, m, nzmax));
+    }
+
+    // Creates the adjacency matrix of a graph in column-compressed form. Entry (i, j) is
+    // the number, or total weight, of edges from i to j. Undirected graphs have symmetric
+    // adjacency matrices, in which self-loops are counted twice, as in igraph_degree().
+    template<typename G, typename = decltype(view(std::declval<const G &>()))>
+    explicit SparseMat(const G &graph, const RealVec *weights = nullptr) {
+        auto &&g = view(graph);
+        const igraph_integer_t n = g.vcount();
+        if (weights)
+            detail::check_edge_weights(g, *weights);
+
+        SparseMat triplet(n, n, g.is_directed() ? g.ecount() : 2 * g.ecount());
+        for (igraph_integer_t v = 0; v < n; ++v) {
+            g.for_each_neighbor(v, IGRAPH_OUT, [&](igraph_integer_t u, igraph_integer_t e) {
+                check(igraph_sparsemat_entry(triplet, v, u, weights ? (*weights)[e] : 1));
+            });
+        }
+        check(igraph_sparsemat_compress(triplet, ptr));
+    }
+
+    SparseMat(SparseMat &&other) noexcept {
+        if (other.is_alias()) {
+            ptr = other.ptr;
+        } else {
+            mat = other.mat;
+        }
+        other.ptr = nullptr;
+    }
+
+    SparseMat(const SparseMat &other) {
+        check(igraph_sparsemat_init_copy(ptr, other.ptr));
+    }
+
+    SparseMat(const igraph_type *m) {
+        check(igraph_sparsemat_init_copy(ptr, m));
+    }
+
+    SparseMat & operator = (const SparseMat &other) = delete;
+
+    SparseMat & operator = (SparseMat &&other) && noexcept {
+        if (! is_alias())
+            igraph_sparsemat_destroy(ptr);
+        if (other.is_alias()) {
+            ptr = other.ptr;
+        } else {
+            mat = other.mat;
+            ptr = &mat;
+        }
+        other.ptr = nullptr;
+        return *this;
+    }
+
+    ~SparseMat() {
+        if (! is_alias())
+            igraph_sparsemat_destroy(ptr);
+    }
+
+    operator igraph_type *() { return ptr; }
+    operator const igraph_type *() const { return ptr; }
+
+    friend void swap(SparseMat &m1, SparseMat &m2) noexcept {
+        igraph_type tmp = *m1.ptr;
+        *m1.ptr = *m2.ptr;
+        *m2.ptr = tmp;
+    }
+
+    size_type nrow() const { return igraph_sparsemat_nrow(ptr); }
+    size_type ncol() const { return igraph_sparsemat_ncol(ptr); }
+
+    // The number of stored entries. In triplet form, these may include duplicates.
+    size_type nonzeros() const { return igraph_sparsemat_nonzero_storage(ptr); }
+
+    bool is_triplet() const { return igraph_sparsemat_is_triplet(ptr); }
+    bool is_cc() const { return igraph_sparsemat_is_cc(ptr); }
+
+    // Adds an entry to a matrix in triplet form. Entries at the same position are summed.
+    void add(size_type i, size_type j, igraph_real_t value) {
+        check(igraph_sparsemat_entry(ptr, i, j, value));
+    }
+
+    // The entry at (i, j) of a matrix in column-compressed form.
+    igraph_real_t operator () (size_type i, size_type j) const {
+        return igraph_sparsemat_get(ptr, i, j);
+    }
+
+    // Returns a copy of the matrix in column-compressed form.
+    SparseMat compress() const {
+        igraph_type res;
+        check(igraph_sparsemat_compress(ptr, &res));
+        return SparseMat(Capture(res));
+    }
+
+    SparseMat transpose() const {
+        igraph_type res;
+        check(igraph_sparsemat_transpose(ptr, &res));
+        return SparseMat(Capture(res));
+    }
+
+    // Calls f(i, j, value) for each stored entry.
+    template<typename F>
+    void for_each(F &&f) const {
+        igraph_sparsemat_iterator_t it;
+        // The iterator does not modify the matrix, but older igraph
+        // versions do not declare the argument const.
+        check(igraph_sparsemat_iterator_init(&it, const_cast<igraph_type *>(ptr)));
+        for (; ! igraph_sparsemat_iterator_end(&it); igraph_sparsemat_iterator_next(&it))
+            f(igraph_sparsemat_iterator_row(&it), igraph_sparsemat_iterator_col(&it), igraph_sparsemat_iterator_get(&it));
+    }
+
+    // Stores the matrix in compressed sparse row form: the entries of row i have column
+    // indices 'index[ptrs[i] .. ptrs[i+1]-1]' and values 'values[ptrs[i] .. ptrs[i+1]-1]'.
+    // For matrices in column-compressed form, the columns within each row are in increasing
+    // order. Duplicate entries are kept separately.
+    void to_csr(IntVec &ptrs, IntVec &index, RealVec &values) const {
+        to_compressed(ptrs, index, values, true);
+    }
+
+    // Stores the matrix in compressed sparse column form, see to_csr().
+    void to_csc(IntVec &ptrs, IntVec &index, RealVec &values) const {
+        to_compressed(ptrs, index, values, false);
+    }
+
+    // Computes y = A x using multiple threads; x and y may be the same vector. Converts
+    // the matrix first; use CSRMat to compute several products with the same matrix.
+    void multiply(const RealVec &x, RealVec &y) const;
+
+    // Computes Y = A X using multiple threads, see above.
+    void multiply(const RealMat &x, RealMat &y) const;
+
+private:
+    void to_compressed(IntVec &ptrs, IntVec &index, RealVec &values, bool by_row) const {
+        const size_type outer = by_row ? nrow() : ncol();
+        const size_type nz = nonzeros();
+
+        // Counting sort by the outer index, done in two passes over the entries.
+        ptrs.resize(outer + 1);
+        std::fill(ptrs.begin(), ptrs.end(), 0);
+        for_each([&](igraph_integer_t i, igraph_integer_t j, igraph_real_t) {
+            ptrs[(by_row ? i : j) + 1]++;
+        });
+        std::partial_sum(ptrs.begin(), ptrs.end(), ptrs.begin());
+
+        IntVec pos = ptrs;
+        index.resize(nz);
+        values.resize(nz);
+        for_each([&](igraph_integer_t i, igraph_integer_t j, igraph_real_t x) {
+            const igraph_integer_t k = pos[by_row ? i : j]++;
+            index[k] = by_row ? j : i;
+            values[k] = x;
+        });
+    }
+};
+
+// A read-only sparse matrix in compressed sparse row form, for computing products
+// with dense vectors and matrices using multiple threads.
+class CSRMat {
+    igraph_integer_t rows = 0, cols = 0;
+    IntVec ptrs, index;
+    RealVec values;
+
+    static constexpr igraph_integer_t grain = 1 << 10;
+
+public:
+    explicit CSRMat(const SparseMat &m) : rows(m.nrow()), cols(m.ncol()) {
+        m.to_csr(ptrs, index, values);
+    }
+
+    igraph_integer_t nrow() const { return rows; }
+    igraph_integer_t ncol() const { return cols; }
+    igraph_integer_t nonzeros() const { return values.size(); }
+
+    // Computes y = A x. x and y may be the same vector.
+    void multiply(const RealVec &x, RealVec &y) const {
+        if (x.size() != cols)
+            throw Exception(IGRAPH_EINVAL);
+        if (x.begin() == y.begin()) {
+            // Rows are computed concurrently, so they must not overwrite the input.
+            RealVec tmp;
+            multiply(x, tmp);
+            y.resize(rows);
+            std::copy(tmp.begin(), tmp.end(), y.begin());
+            return;
+        }
+        y.resize(rows);
+        detail::parallel_for(rows, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            for (igraph_integer_t i = begin; i < end; ++i) {
+                igraph_real_t sum = 0;
+                for (igraph_integer_t k = ptrs[i]; k < ptrs[i + 1]; ++k)
+                    sum += values[k] * x[index[k]];
+                y[i] = sum;
+            }
+        });
+    }
+
+    // Computes Y = A X. Each thread processes a block of rows of the result for all
+    // columns of X, reusing the same part of the sparse matrix from cache. X and Y may be
+    // the same matrix.
+    void multiply(const RealMat &x, RealMat &y) const {
+        if (x.nrow() != cols)
+            throw Exception(IGRAPH_EINVAL);
+        if (x.begin() == y.begin()) {
+            RealMat tmp;
+            multiply(x, tmp);
+            y.resize(rows, x.ncol());
+            std::copy(tmp.begin(), tmp.end(), y.begin());
+            return;
+        }
+        const igraph_integer_t k = x.ncol();
+        y.resize(rows, k);
+        detail::parallel_for(rows, grain, [&](igraph_integer_t begin, igraph_integer_t end, unsigned) {
+            for (igraph_integer_t j = 0; j < k; ++j) {
+                const igraph_real_t *xj = &x(0, j);
+                for (igraph_integer_t i = begin; i < end; ++i) {
+                    igraph_real_t sum = 0;
+                    for (igraph_integer_t p = ptrs[i]; p < ptrs[i + 1]; ++p)
+                        sum += values[p] * xj[index[p]];
+                    y(i, j) = sum;
+                }
+            }
+        });
+    }
+};
+
+inline void SparseMat::multiply(const RealVec &x, RealVec &y) const {
+    CSRMat(*this).multiply(x, y);
+}
+
+inline void SparseMat::multiply(const RealMat &x, RealMat &y) const {
+    CSRMat(*this).multiply(x, y);
+}
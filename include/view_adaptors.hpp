@@ -0,0 +1,123 @@
+
+// Reversed and undirected views of a graph.
+//
+// igraph indexes the edges of a graph both by source (oi) and by target (ii), so the
+// transpose of a directed graph, and its undirected version, are available without
+// rebuilding anything: reversed() swaps the out- and in-neighbour ranges at iteration
+// time, and as_undirected() merges them. Both work on a Graph or on any of its views,
+// and return views that can be passed to the algorithms of igraph-cpp. The viewed
+// graph must outlive them.
+
+namespace detail {
+
+// Holds the result of view(): a copy of lightweight views returned by value, such as
+// GraphView, and a pointer to views returned by reference.
+template<typename V>
+class ViewHolder {
+    V v;
+public:
+    explicit ViewHolder(V v_) : v(v_) { }
+    const V &get() const { return v; }
+};
+
+template<typename V>
+class ViewHolder<const V &> {
+    const V *v;
+public:
+    explicit ViewHolder(const V &v_) : v(&v_) { }
+    const V &get() const { return *v; }
+};
+
+} // namespace detail
+
+// The transpose of a graph: every edge is followed in the opposite direction, and keeps
+// its ID. For undirected graphs, this is the graph itself.
+template<typename V>
+class ReversedView {
+    detail::ViewHolder<V> graph;
+
+public:
+    template<typename G>
+    explicit ReversedView(const G &g) : graph(view(g)) { }
+
+    igraph_integer_t vcount() const { return graph.get().vcount(); }
+    igraph_integer_t ecount() const { return graph.get().ecount(); }
+    bool is_directed() const { return graph.get().is_directed(); }
+
+    igraph_integer_t from(igraph_integer_t e) const { return graph.get().to(e); }
+    igraph_integer_t to(igraph_integer_t e) const { return graph.get().from(e); }
+    bool is_deleted(igraph_integer_t e) const { return detail::edge_deleted(graph.get(), e, 0); }
+
+    igraph_integer_t degree(igraph_integer_t v, igraph_neimode_t mode = IGRAPH_OUT) const {
+        return graph.get().degree(v, detail::reverse_mode(mode));
+    }
+
+    // See GraphView::for_each_neighbor().
+    template<typename F>
+    bool for_each_neighbor(igraph_integer_t v, igraph_neimode_t mode, F &&f) const {
+        return graph.get().for_each_neighbor(v, detail::reverse_mode(mode), f);
+    }
+};
+
+// A graph with edge directions ignored. Each directed edge becomes an undirected edge
+// with the same ID, so mutual edges become parallel edges, as with
+// igraph_to_undirected() and IGRAPH_TO_UNDIRECTED_EACH.
+template<typename V>
+class UndirectedView {
+    detail::ViewHolder<V> graph;
+
+public:
+    template<typename G>
+    explicit UndirectedView(const G &g) : graph(view(g)) { }
+
+    igraph_integer_t vcount() const { return graph.get().vcount(); }
+    igraph_integer_t ecount() const { return graph.get().ecount(); }
+    bool is_directed() const { return false; }
+
+    // As for undirected graphs in igraph, from(e) >= to(e).
+    igraph_integer_t from(igraph_integer_t e) const {
+        return std::max(graph.get().from(e), graph.get().to(e));
+    }
+    igraph_integer_t to(igraph_integer_t e) const {
+        return std::min(graph.get().from(e), graph.get().to(e));
+    }
+    bool is_deleted(igraph_integer_t e) const { return detail::edge_deleted(graph.get(), e, 0); }
+
+    igraph_integer_t degree(igraph_integer_t v, igraph_neimode_t = IGRAPH_ALL) const {
+        return graph.get().degree(v, IGRAPH_ALL);
+    }
+
+    // See GraphView::for_each_neighbor(). The mode is ignored.
+    template<typename F>
+    bool for_each_neighbor(igraph_integer_t v, igraph_neimode_t, F &&f) const {
+        return graph.get().for_each_neighbor(v, IGRAPH_ALL, f);
+    }
+};
+
+namespace detail {
+
+template<typename V>
+struct reports_edge_ids<ReversedView<V>> : reports_edge_ids<typename std::decay<V>::type> { };
+
+template<typename V>
+struct reports_edge_ids<UndirectedView<V>> : reports_edge_ids<typename std::decay<V>::type> { };
+
+} // namespace detail
+
+template<typename V>
+const ReversedView<V> &view(const ReversedView<V> &graph) { return graph; }
+
+template<typename V>
+const UndirectedView<V> &view(const UndirectedView<V> &graph) { return graph; }
+
+// A view of 'graph' with all edges reversed, see ReversedView.
+template<typename G>
+ReversedView<decltype(view(std::declval<const G &>()))> reversed(const G &graph) {
+    return ReversedView<decltype(view(std::declval<const G &>()))>(graph);
+}
+
+// A view of 'graph' with edge directions ignored, see UndirectedView.
+template<typename G>
+UndirectedView<decltype(view(std::declval<const G &>()))> as_undirected(const G &graph) {
+    return UndirectedView<decltype(view(std::declval<const G &>()))>(graph);
+}